@@ -0,0 +1,422 @@
+/*
+ * Benchmark.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include "../constant.h"
+#include "../Network/Network.hpp"
+#include "../Network/Simd/Simd.hpp"
+
+using namespace std;
+
+/**
+ * Matrix of cases to run (every combination is a case) and measure settings
+ */
+struct Options {
+	vector<size_t> widths = { 8, 32, 128, 512, 2048, 8192 };
+	vector<size_t> depths = { 1, 2, 4 };
+	vector<ExcitationType> excitations = { ExcitationType::SIGMOID, ExcitationType::TAN_HYP, ExcitationType::STEP };
+	vector<size_t> batchSizes = { 1, 32, 256 };
+	vector<size_t> threadsCounts;
+	vector<string> scalars = { "float", "double" };
+
+	/**
+	 * Threads estimating one sample at once with the same network (1: no concurrent measure)
+	 */
+	size_t concurrentCount = 1;
+
+	/**
+	 * Minimum measured time of each measure (in seconds)
+	 */
+	double minTime = 0.2;
+
+	/**
+	 * Cases with more links are skipped (memory bound)
+	 */
+	size_t maxLinks = (size_t)1 << 26;
+
+	/**
+	 * JSON output file (standard output if empty)
+	 */
+	string output;
+};
+
+/**
+ * Result of a measure
+ */
+struct Measure {
+	size_t iterations = 0;
+	double seconds = 0;
+	double samplesPerSecond = 0;
+	double gflops = 0;
+};
+
+/**
+ * Split a comma separated list
+ * @param value list
+ * @return items
+ */
+static vector<string> split(const string& value) {
+	vector<string> items;
+	stringstream stream(value);
+	string item;
+	while (getline(stream, item, ',')) {
+		if (!item.empty()) {
+			items.push_back(item);
+		}
+	}
+	return items;
+}
+
+/**
+ * Parse a comma separated list of positive numbers
+ * @param value list
+ * @return numbers
+ * @throw invalid_argument if a number is not valid
+ */
+static vector<size_t> parseSizes(const string& value) {
+	vector<size_t> sizes;
+	for (const string& item : split(value)) {
+		size_t end = 0;
+		unsigned long long size = 0;
+		try {
+			size = stoull(item, &end);
+		} catch (const logic_error&) {
+			end = 0;
+		}
+		if (end != item.size() || size == 0) {
+			throw invalid_argument("Invalid number: " + item);
+		}
+		sizes.push_back((size_t)size);
+	}
+	return sizes;
+}
+
+/**
+ * Get the name of an excitation type
+ * @param eT excitation type
+ * @return name
+ */
+static string getName(ExcitationType eT) {
+	switch (eT) {
+	case ExcitationType::SIGMOID:
+		return "SIGMOID";
+	case ExcitationType::STEP:
+		return "STEP";
+	case ExcitationType::TAN_HYP:
+		return "TAN_HYP";
+	case ExcitationType::SOFTMAX:
+		return "SOFTMAX";
+	default:
+		return "NO_EXC";
+	}
+}
+
+/**
+ * Parse a comma separated list of excitation types
+ * @param value list
+ * @return excitation types
+ * @throw invalid_argument if a name is not valid
+ */
+static vector<ExcitationType> parseExcitations(const string& value) {
+	vector<ExcitationType> excitations;
+	for (const string& item : split(value)) {
+		bool found = false;
+		for (ExcitationType eT : { ExcitationType::SIGMOID, ExcitationType::TAN_HYP, ExcitationType::STEP }) {
+			if (item == getName(eT)) {
+				excitations.push_back(eT);
+				found = true;
+			}
+		}
+		if (!found) {
+			throw invalid_argument("Invalid excitation: " + item);
+		}
+	}
+	return excitations;
+}
+
+/**
+ * Parse the command line
+ * @param argc number of arguments
+ * @param argv arguments
+ * @return options
+ * @throw invalid_argument if an argument is not valid
+ */
+static Options parseOptions(int argc, char** argv) {
+	Options options;
+	for (int i = 1; i < argc; ++i) {
+		string name = argv[i];
+		if (name == "--quick") {
+			options.widths = { 8, 128, 1024 };
+			options.depths = { 2 };
+			options.excitations = { ExcitationType::SIGMOID };
+			options.batchSizes = { 1, 64 };
+			options.minTime = 0.05;
+			continue;
+		}
+		if (i + 1 >= argc) {
+			throw invalid_argument("Missing value of " + name);
+		}
+		string value = argv[++i];
+		if (name == "--widths") {
+			options.widths = parseSizes(value);
+		} else if (name == "--depths") {
+			options.depths = parseSizes(value);
+		} else if (name == "--excitations") {
+			options.excitations = parseExcitations(value);
+		} else if (name == "--batches") {
+			options.batchSizes = parseSizes(value);
+		} else if (name == "--threads") {
+			options.threadsCounts = parseSizes(value);
+		} else if (name == "--scalars") {
+			options.scalars = split(value);
+			for (const string& scalar : options.scalars) {
+				if (scalar != "float" && scalar != "double") {
+					throw invalid_argument("Invalid scalar: " + scalar);
+				}
+			}
+		} else if (name == "--min-time") {
+			options.minTime = stod(value);
+		} else if (name == "--concurrent") {
+			options.concurrentCount = parseSizes(value).at(0);
+		} else if (name == "--max-links") {
+			options.maxLinks = parseSizes(value).at(0);
+		} else if (name == "--output") {
+			options.output = value;
+		} else {
+			throw invalid_argument("Unknown argument: " + name);
+		}
+	}
+
+	// 1 thread and every power of 2 up to the number of cores by default
+	if (options.threadsCounts.empty()) {
+		size_t coresCount = max(1u, thread::hardware_concurrency());
+		for (size_t t = 1; t < coresCount; t *= 2) {
+			options.threadsCounts.push_back(t);
+		}
+		options.threadsCounts.push_back(coresCount);
+	}
+	return options;
+}
+
+/**
+ * Run a function until the minimum time is reached (after a warm-up run)
+ * @param minTime minimum measured time (in seconds)
+ * @param samplesCount samples processed by a run
+ * @param flops floating-point operations of a run
+ * @param run function to measure
+ * @return measure (median time of a run)
+ */
+static Measure measure(double minTime, size_t samplesCount, double flops, const function<void()>& run) {
+	typedef chrono::steady_clock Clock;
+	run();
+
+	vector<double> times;
+	double total = 0;
+	do {
+		Clock::time_point start = Clock::now();
+		run();
+		double time = chrono::duration<double>(Clock::now() - start).count();
+		times.push_back(time);
+		total += time;
+	} while (total < minTime);
+
+	sort(times.begin(), times.end());
+	Measure result;
+	result.iterations = times.size();
+	result.seconds = times.at(times.size() / 2);
+	result.samplesPerSecond = samplesCount / result.seconds;
+	result.gflops = flops / result.seconds * 1e-9;
+	return result;
+}
+
+/**
+ * Write a measure as a JSON object
+ * @param out output stream
+ * @param m measure
+ */
+static void writeMeasure(ostream& out, const Measure& m) {
+	out << "{\"iterations\": " << m.iterations << ", \"seconds\": " << m.seconds
+		<< ", \"samplesPerSecond\": " << m.samplesPerSecond << ", \"gflops\": " << m.gflops << "}";
+}
+
+/**
+ * Run every case of a scalar type
+ * @param options options
+ * @param scalar name of the scalar type
+ * @param out JSON output
+ * @param first no case written yet
+ */
+template<typename T>
+static void runCases(const Options& options, const string& scalar, ostream& out, bool& first) {
+	mt19937_64 generator(42);
+	uniform_real_distribution<double> distribution(0, 1);
+
+	for (size_t width : options.widths) {
+		for (size_t depth : options.depths) {
+			// Depth is the number of connected layers (hidden layers and the output layer)
+			size_t linksCount = width * width * depth;
+			if (linksCount > options.maxLinks) {
+				cerr << "skip " << scalar << " width " << width << " depth " << depth << " (" << linksCount << " links)" << endl;
+				continue;
+			}
+
+			for (ExcitationType eT : options.excitations) {
+				Network<T> n((T) 0.01);
+				n.addInputLayer((unsigned int)width);
+				for (size_t d = 1; d < depth; ++d) {
+					n.addLayer((unsigned int)width, AggregationType::SUM, eT);
+				}
+				n.addOutputLayer((unsigned int)width, AggregationType::SUM, eT);
+
+				for (size_t batchSize : options.batchSizes) {
+					// Random inputs, one hot expected values
+					Matrix<T> inputValues(batchSize, width);
+					Matrix<T> expectedValues(batchSize, width, 0);
+					for (size_t r = 0; r < batchSize; ++r) {
+						for (size_t c = 0; c < width; ++c) {
+							inputValues.at(r, c) = (T) distribution(generator);
+						}
+						expectedValues.at(r, generator() % width) = 1;
+					}
+					vector<T> sample(inputValues.row(0), inputValues.row(0) + width);
+					vector<T> expectedSample(expectedValues.row(0), expectedValues.row(0) + width);
+					vector<T> outputValues;
+					Matrix<T> batchOutputValues;
+					Scratch<T> scratch;
+
+					for (size_t threadsCount : options.threadsCounts) {
+						n.setThreadsCount((unsigned int)threadsCount);
+						cerr << scalar << " width " << width << " depth " << depth << " " << getName(eT)
+							<< " batch " << batchSize << " threads " << threadsCount << endl;
+
+						// Forward: 2 flops by link and by sample (the latency path for a single sample)
+						double forwardFlops = 2.0 * linksCount * batchSize;
+						Measure forward = measure(options.minTime, batchSize, forwardFlops, [&]() {
+							if (batchSize == 1) {
+								n.estimate(sample, outputValues, scratch);
+							} else {
+								n.estimateBatch(inputValues, batchOutputValues);
+							}
+						});
+
+						// Concurrent single samples: the callers share the network and its pool, they
+						// should neither wait for each other nor change the result
+						Measure concurrent;
+						bool isConcurrent = batchSize == 1 && options.concurrentCount > 1;
+						if (isConcurrent) {
+							const size_t RUNS_BY_CALLER = 8;
+							vector<vector<T>> callerOutputValues(options.concurrentCount);
+							concurrent = measure(options.minTime, options.concurrentCount * RUNS_BY_CALLER, forwardFlops * options.concurrentCount * RUNS_BY_CALLER, [&]() {
+								vector<thread> callers;
+								for (size_t c = 0; c < options.concurrentCount; ++c) {
+									callers.emplace_back([&, c]() {
+										Scratch<T> callerScratch;
+										for (size_t r = 0; r < RUNS_BY_CALLER; ++r) {
+											n.estimate(sample, callerOutputValues[c], callerScratch);
+										}
+									});
+								}
+								for (thread& caller : callers) {
+									caller.join();
+								}
+							});
+							for (const vector<T>& values : callerOutputValues) {
+								if (values != outputValues) {
+									throw runtime_error("Concurrent estimations differ from a single estimation");
+								}
+							}
+						}
+
+						// Training: forward, deltas and gradients (2 flops by link each) and update
+						// (the online learning for a single sample)
+						double trainingFlops = 3 * forwardFlops;
+						Measure training = measure(options.minTime, batchSize, trainingFlops, [&]() {
+							if (batchSize == 1) {
+								n.learn(sample, expectedSample);
+							} else {
+								n.learnBatch(inputValues, expectedValues);
+							}
+						});
+
+						// Backward: training time without the forward time
+						Measure backward;
+						backward.iterations = training.iterations;
+						backward.seconds = max(training.seconds - forward.seconds, 1e-9);
+						backward.samplesPerSecond = batchSize / backward.seconds;
+						backward.gflops = 2 * forwardFlops / backward.seconds * 1e-9;
+
+						out << (first ? "\n" : ",\n") << "    {\"scalar\": \"" << scalar << "\", \"width\": " << width
+							<< ", \"depth\": " << depth << ", \"excitation\": \"" << getName(eT) << "\", \"batchSize\": " << batchSize
+							<< ", \"threads\": " << threadsCount << ", \"links\": " << linksCount << ",\n     \"forward\": ";
+						writeMeasure(out, forward);
+						if (isConcurrent) {
+							out << ",\n     \"concurrentForward\": ";
+							writeMeasure(out, concurrent);
+						}
+						out << ",\n     \"backward\": ";
+						writeMeasure(out, backward);
+						out << ",\n     \"training\": ";
+						writeMeasure(out, training);
+						out << "}";
+						out.flush();
+						first = false;
+					}
+				}
+			}
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	try {
+		Options options = parseOptions(argc, argv);
+
+		ofstream file;
+		if (!options.output.empty()) {
+			file.open(options.output);
+			if (!file) {
+				throw runtime_error("Unable to open " + options.output);
+			}
+		}
+		ostream& out = options.output.empty() ? cout : file;
+
+#if defined(ANN_SIMD_AVX512)
+		string simd = "avx512";
+#elif defined(ANN_SIMD_AVX2)
+		string simd = "avx2";
+#else
+		string simd = "scalar";
+#endif
+		out << "{\n  \"version\": 1,\n  \"simd\": \"" << simd << "\",\n  \"hardwareThreads\": " << thread::hardware_concurrency()
+			<< ",\n  \"minTime\": " << options.minTime << ",\n  \"results\": [";
+
+		bool first = true;
+		for (const string& scalar : options.scalars) {
+			if (scalar == "float") {
+				runCases<float>(options, scalar, out, first);
+			} else {
+				runCases<double>(options, scalar, out, first);
+			}
+		}
+		out << "\n  ]\n}" << endl;
+	} catch (const exception& e) {
+		cerr << e.what() << endl;
+		return 1;
+	}
+	return 0;
+}
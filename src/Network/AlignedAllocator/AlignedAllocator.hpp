@@ -0,0 +1,92 @@
+/*
+ * AlignedAllocator.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef ALIGNEDALLOCATOR_ALIGNEDALLOCATOR_HPP_
+#define ALIGNEDALLOCATOR_ALIGNEDALLOCATOR_HPP_
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#endif
+
+/**
+ * Allocator of arrays starting on a cache line (no false sharing, aligned SIMD loads)
+ */
+template<typename T>
+class AlignedAllocator {
+public:
+	typedef T value_type;
+
+	/**
+	 * Alignment of the arrays
+	 */
+	static const size_t ALIGNMENT = 64;
+
+	AlignedAllocator() = default;
+
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U>&) {}
+
+	template<typename U>
+	struct rebind {
+		typedef AlignedAllocator<U> other;
+	};
+
+	/**
+	 * Allocate an aligned array
+	 * @param n number of values
+	 * @return array
+	 * @throw bad_alloc if there is not enough memory
+	 */
+	T* allocate(size_t n) {
+		if (n == 0) {
+			return nullptr;
+		}
+		if (n > (size_t) -1 / sizeof(T)) {
+			throw std::bad_alloc();
+		}
+#if defined(_WIN32)
+		void* p = _aligned_malloc(n * sizeof(T), ALIGNMENT);
+#else
+		void* p = nullptr;
+		if (posix_memalign(&p, ALIGNMENT, n * sizeof(T)) != 0) {
+			p = nullptr;
+		}
+#endif
+		if (!p) {
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(p);
+	}
+
+	/**
+	 * Free an array
+	 * @param p array
+	 */
+	void deallocate(T* p, size_t) {
+#if defined(_WIN32)
+		_aligned_free(p);
+#else
+		free(p);
+#endif
+	}
+};
+
+template<typename T, typename U>
+bool operator==(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+	return true;
+}
+
+template<typename T, typename U>
+bool operator!=(const AlignedAllocator<T>&, const AlignedAllocator<U>&) {
+	return false;
+}
+
+#endif /* ALIGNEDALLOCATOR_ALIGNEDALLOCATOR_HPP_ */
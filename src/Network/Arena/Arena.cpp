@@ -0,0 +1,63 @@
+/*
+ * Arena.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+
+#include "Arena.hpp"
+
+template<typename T>
+Arena<T>::Arena() {
+	usedCount = 0;
+}
+
+template<typename T>
+size_t Arena<T>::align(size_t count) {
+	const size_t lineCount = AlignedAllocator<T>::ALIGNMENT / sizeof(T);
+	return (count + lineCount - 1) / lineCount * lineCount;
+}
+
+template<typename T>
+void Arena<T>::reserve(size_t count) {
+	// A new vector: the storage is released even if the capacity is smaller
+	std::vector<T, AlignedAllocator<T>>(count, 0).swap(values);
+	usedCount = 0;
+}
+
+template<typename T>
+T* Arena<T>::allocate(size_t count) {
+	size_t alignedCount = align(count);
+	if (alignedCount > values.size() - usedCount) {
+		throw std::logic_error("The arena is exhausted");
+	}
+
+	T* array = values.data() + usedCount;
+	usedCount += alignedCount;
+	return array;
+}
+
+template<typename T>
+T* Arena<T>::data() {
+	return values.data();
+}
+
+template<typename T>
+const T* Arena<T>::data() const {
+	return values.data();
+}
+
+template<typename T>
+size_t Arena<T>::getSize() const {
+	return usedCount;
+}
+
+template<typename T>
+size_t Arena<T>::getCapacity() const {
+	return values.size();
+}
+
+template class Arena<float>;
+template class Arena<double>;
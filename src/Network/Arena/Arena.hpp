@@ -0,0 +1,82 @@
+/*
+ * Arena.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef ARENA_ARENA_HPP_
+#define ARENA_ARENA_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "../AlignedAllocator/AlignedAllocator.hpp"
+
+/**
+ * One aligned allocation shared by all the arrays of a network
+ *
+ * The capacity is reserved once, the arrays are then taken one after the other (each one
+ * starting on a cache line) and never move: they are freed together with the arena
+ */
+template<typename T>
+class Arena {
+protected:
+	/**
+	 * Storage of the arrays
+	 */
+	std::vector<T, AlignedAllocator<T>> values;
+
+	/**
+	 * Number of values already taken
+	 */
+	size_t usedCount;
+
+public:
+	/**
+	 * Constructor
+	 */
+	Arena();
+
+	/**
+	 * Round a number of values up to a whole number of cache lines
+	 * @param count number of values
+	 * @return aligned number of values
+	 */
+	static size_t align(size_t count);
+
+	/**
+	 * Allocate the storage (zero filled), the previous arrays are freed
+	 * @param count number of values (sum of the aligned sizes of the arrays)
+	 */
+	void reserve(size_t count);
+
+	/**
+	 * Take an array
+	 * @param count number of values
+	 * @return first value of the array (aligned on a cache line)
+	 * @throw logic_error if the reserved storage is exhausted
+	 */
+	T* allocate(size_t count);
+
+	/**
+	 * Get first value of the arena
+	 * @return first value
+	 */
+	T* data();
+	const T* data() const;
+
+	/**
+	 * Get number of values already taken (including the alignment)
+	 * @return number of values
+	 */
+	size_t getSize() const;
+
+	/**
+	 * Get number of values reserved
+	 * @return number of values
+	 */
+	size_t getCapacity() const;
+};
+
+#endif /* ARENA_ARENA_HPP_ */
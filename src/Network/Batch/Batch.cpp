@@ -0,0 +1,97 @@
+/*
+ * Batch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Batch.hpp"
+#include "../Kernel/Kernel.hpp"
+
+template<typename T>
+Batch<T>::Batch() {
+	size = 0;
+}
+
+template<typename T>
+void Batch<T>::resize(const std::vector<Layer<T>>& layers, size_t batchSize) {
+	// Nothing to do if the shape is unchanged
+	if (batchSize == size && inputValues.size() == layers.size()) {
+		return;
+	}
+
+	size = batchSize;
+	inputValues.resize(layers.size());
+	outputValues.resize(layers.size());
+	derivatives.resize(layers.size());
+	deltas.resize(layers.size());
+	weightsGradients.resize(layers.size());
+	biasesGradients.resize(layers.size());
+
+	for (size_t i = 0; i < layers.size(); ++i) {
+		size_t neuralsCount = layers.at(i).getNeuralsCount();
+		inputValues.at(i).resize(batchSize, neuralsCount);
+		outputValues.at(i).resize(batchSize, neuralsCount);
+		derivatives.at(i).resize(batchSize, neuralsCount);
+		deltas.at(i).resize(batchSize, neuralsCount);
+		if (layers.at(i).isSparse()) {
+			weightsGradients.at(i).resize(1, layers.at(i).getLinksCount());
+		} else {
+			weightsGradients.at(i).resize(neuralsCount, layers.at(i).getInputsCount());
+		}
+		biasesGradients.at(i).resize(neuralsCount);
+	}
+	expectedValues.resize(batchSize, layers.back().getNeuralsCount());
+}
+
+template<typename T>
+size_t Batch<T>::getSize() const {
+	return size;
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getInputValues(size_t layer) {
+	return inputValues.at(layer);
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getOutputValues(size_t layer) {
+	return outputValues.at(layer);
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getDerivatives(size_t layer) {
+	return derivatives.at(layer);
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getDeltas(size_t layer) {
+	return deltas.at(layer);
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getWeightsGradients(size_t layer) {
+	return weightsGradients.at(layer);
+}
+
+template<typename T>
+std::vector<T>& Batch<T>::getBiasesGradients(size_t layer) {
+	return biasesGradients.at(layer);
+}
+
+template<typename T>
+Matrix<T>& Batch<T>::getExpectedValues() {
+	return expectedValues;
+}
+
+template<typename T>
+void Batch<T>::accumulate(Batch<T>& other) {
+	for (size_t i = 0; i < weightsGradients.size(); ++i) {
+		Matrix<T>& gradients = weightsGradients.at(i);
+		Kernel::axpy<T>(gradients.getRowsCount() * gradients.getColsCount(), 1, other.getWeightsGradients(i).data(), gradients.data());
+		Kernel::axpy<T>(biasesGradients.at(i).size(), 1, other.getBiasesGradients(i).data(), biasesGradients.at(i).data());
+	}
+}
+
+template class Batch<float>;
+template class Batch<double>;
@@ -0,0 +1,137 @@
+/*
+ * Batch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef BATCH_BATCH_HPP_
+#define BATCH_BATCH_HPP_
+
+#include <vector>
+
+#include "../Matrix/Matrix.hpp"
+#include "../Layer/Layer.hpp"
+
+/**
+ * Working buffers of a mini-batch: values, derivatives and deltas of every layer for every sample,
+ * and the accumulated gradients of every layer
+ */
+template<typename T>
+class Batch {
+protected:
+	/**
+	 * Number of samples
+	 */
+	size_t size;
+
+	/**
+	 * Neurals input values by layer (size x neuralsCount)
+	 */
+	std::vector<Matrix<T>> inputValues;
+
+	/**
+	 * Neurals output values by layer (size x neuralsCount)
+	 */
+	std::vector<Matrix<T>> outputValues;
+
+	/**
+	 * Neurals derivatives f'(input values) by layer (size x neuralsCount)
+	 */
+	std::vector<Matrix<T>> derivatives;
+
+	/**
+	 * Neurals deltas by layer (size x neuralsCount)
+	 */
+	std::vector<Matrix<T>> deltas;
+
+	/**
+	 * Weights gradients by layer (neuralsCount x inputsCount, 1 x linksCount if sparse)
+	 */
+	std::vector<Matrix<T>> weightsGradients;
+
+	/**
+	 * Biases gradients by layer (neuralsCount)
+	 */
+	std::vector<std::vector<T>> biasesGradients;
+
+	/**
+	 * Expected values (size x outputsCount)
+	 */
+	Matrix<T> expectedValues;
+
+public:
+	/**
+	 * Constructor
+	 */
+	Batch();
+
+	/**
+	 * Allocate the buffers for the layers (nothing is done if the shape is unchanged)
+	 * @param layers layers of the network
+	 * @param batchSize number of samples
+	 */
+	void resize(const std::vector<Layer<T>>& layers, size_t batchSize);
+
+	/**
+	 * Get number of samples
+	 * @return number of samples
+	 */
+	size_t getSize() const;
+
+	/**
+	 * Get input values of a layer
+	 * @param layer layer index
+	 * @return input values
+	 */
+	Matrix<T>& getInputValues(size_t layer);
+
+	/**
+	 * Get output values of a layer
+	 * @param layer layer index
+	 * @return output values
+	 */
+	Matrix<T>& getOutputValues(size_t layer);
+
+	/**
+	 * Get derivatives of a layer
+	 * @param layer layer index
+	 * @return derivatives
+	 */
+	Matrix<T>& getDerivatives(size_t layer);
+
+	/**
+	 * Get deltas of a layer
+	 * @param layer layer index
+	 * @return deltas
+	 */
+	Matrix<T>& getDeltas(size_t layer);
+
+	/**
+	 * Get weights gradients of a layer
+	 * @param layer layer index
+	 * @return weights gradients
+	 */
+	Matrix<T>& getWeightsGradients(size_t layer);
+
+	/**
+	 * Get biases gradients of a layer
+	 * @param layer layer index
+	 * @return biases gradients
+	 */
+	std::vector<T>& getBiasesGradients(size_t layer);
+
+	/**
+	 * Get expected values
+	 * @return expected values
+	 */
+	Matrix<T>& getExpectedValues();
+
+	/**
+	 * Add the gradients of another batch to the gradients of this batch
+	 * @param other batch of the same network
+	 */
+	void accumulate(Batch<T>& other);
+};
+
+#endif /* BATCH_BATCH_HPP_ */
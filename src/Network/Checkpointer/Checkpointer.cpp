@@ -0,0 +1,268 @@
+/*
+ * Checkpointer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <cstdio>
+#include <sstream>
+#include <iomanip>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Checkpointer.hpp"
+
+namespace {
+
+#if defined(_WIN32)
+
+	/**
+	 * Flush a written file to the disk
+	 * @param path path of the file
+	 * @throw runtime_error if the file can not be flushed
+	 */
+	void syncFile(const std::string& path) {
+		HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (handle == INVALID_HANDLE_VALUE) {
+			throw std::runtime_error("Can not open " + path);
+		}
+		BOOL flushed = FlushFileBuffers(handle);
+		CloseHandle(handle);
+		if (!flushed) {
+			throw std::runtime_error("Can not flush " + path);
+		}
+	}
+
+	/**
+	 * Rename a file, replacing the destination in one step
+	 * @param from path of the file
+	 * @param to new path of the file
+	 * @throw runtime_error if the file can not be renamed
+	 */
+	void replaceFile(const std::string& from, const std::string& to) {
+		if (!MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+			throw std::runtime_error("Can not rename " + from);
+		}
+	}
+
+	/**
+	 * Flush the directory of a file (the rename is written through)
+	 * @param path path of the file
+	 */
+	void syncDirectory(const std::string&) {
+	}
+
+#else
+
+	void syncFile(const std::string& path) {
+		int fd = open(path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			throw std::runtime_error("Can not open " + path);
+		}
+		int result = fsync(fd);
+		close(fd);
+		if (result != 0) {
+			throw std::runtime_error("Can not flush " + path);
+		}
+	}
+
+	void replaceFile(const std::string& from, const std::string& to) {
+		if (std::rename(from.c_str(), to.c_str()) != 0) {
+			throw std::runtime_error("Can not rename " + from);
+		}
+	}
+
+	void syncDirectory(const std::string& path) {
+		// The new entry of the directory (best effort: not every file system allows it)
+		size_t separator = path.find_last_of('/');
+		std::string directory = (separator == std::string::npos) ? "." : (separator == 0) ? "/" : path.substr(0, separator);
+		int fd = open(directory.c_str(), O_RDONLY);
+		if (fd >= 0) {
+			fsync(fd);
+			close(fd);
+		}
+	}
+
+#endif
+
+}
+
+template<typename T>
+Checkpointer<T>::Checkpointer(const Network<T>& network, const std::string& pathPrefix, unsigned int keptCount) : network(network), pathPrefix(pathPrefix) {
+	// Check if the network is ready
+	size_t layersCount = network.getLayersCount();
+	if (layersCount < 2 || network.getLayer(layersCount - 1).getType() != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("The network is not complete");
+	}
+
+	// Buffers allocated once
+	this->keptCount = keptCount;
+	for (int i = 0; i < 2; ++i) {
+		parameters[i].resize(network.getParametersCount());
+		steps[i] = 0;
+		states[i] = BufferState::FREE;
+	}
+	writtenCount = 0;
+	replacedCount = 0;
+	stopping = false;
+
+	writer = std::thread(&Checkpointer<T>::write, this);
+}
+
+template<typename T>
+Checkpointer<T>::~Checkpointer() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	writer.join();
+}
+
+template<typename T>
+void Checkpointer<T>::write() {
+	while (true) {
+		// Wait for a snapshot (the oldest one first)
+		int buffer = -1;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return stopping || states[0] == BufferState::PENDING || states[1] == BufferState::PENDING; });
+			for (int i = 0; i < 2; ++i) {
+				if (states[i] == BufferState::PENDING && (buffer < 0 || steps[i] < steps[buffer])) {
+					buffer = i;
+				}
+			}
+			if (buffer < 0) {
+				return;
+			}
+			states[buffer] = BufferState::WRITING;
+		}
+
+		// Write outside the lock: the learning thread takes the other buffer meanwhile
+		try {
+			writeCheckpoint(buffer);
+		} catch (...) {
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			states[buffer] = BufferState::FREE;
+		}
+		condition.notify_all();
+	}
+}
+
+template<typename T>
+void Checkpointer<T>::writeCheckpoint(int buffer) {
+	std::ostringstream name;
+	name << pathPrefix << "-" << std::setw(10) << std::setfill('0') << steps[buffer] << ".annm";
+	std::string path = name.str();
+	std::string temporaryPath = path + ".tmp";
+
+	// Complete file on the disk before it takes its final name
+	network.save(temporaryPath, parameters[buffer].data());
+	syncFile(temporaryPath);
+	replaceFile(temporaryPath, path);
+	syncDirectory(path);
+
+	// Remove the oldest checkpoints
+	std::lock_guard<std::mutex> lock(mutex);
+	if (paths.empty() || paths.back() != path) {
+		paths.push_back(path);
+	}
+	while (keptCount > 0 && paths.size() > keptCount) {
+		std::remove(paths.front().c_str());
+		paths.pop_front();
+	}
+	++writtenCount;
+}
+
+template<typename T>
+void Checkpointer<T>::checkError() {
+	std::exception_ptr e;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		e = error;
+		error = nullptr;
+	}
+	if (e) {
+		std::rethrow_exception(e);
+	}
+}
+
+template<typename T>
+void Checkpointer<T>::snapshot(uint64_t step) {
+	checkError();
+
+	// A free buffer, otherwise the oldest snapshot not yet written (one buffer at most is written)
+	int buffer = -1;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		for (int i = 0; i < 2; ++i) {
+			if (states[i] == BufferState::FREE) {
+				buffer = i;
+				break;
+			}
+		}
+		if (buffer < 0) {
+			for (int i = 0; i < 2; ++i) {
+				if (states[i] == BufferState::PENDING && (buffer < 0 || steps[i] < steps[buffer])) {
+					buffer = i;
+				}
+			}
+			++replacedCount;
+		}
+		states[buffer] = BufferState::FILLING;
+	}
+
+	// Copy outside the lock: the writing thread does not use this buffer
+	network.copyParameters(parameters[buffer].data());
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		steps[buffer] = step;
+		states[buffer] = BufferState::PENDING;
+	}
+	condition.notify_all();
+}
+
+template<typename T>
+void Checkpointer<T>::wait() {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this] { return states[0] == BufferState::FREE && states[1] == BufferState::FREE; });
+	}
+	checkError();
+}
+
+template<typename T>
+std::string Checkpointer<T>::getLastPath() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return paths.empty() ? std::string() : paths.back();
+}
+
+template<typename T>
+uint64_t Checkpointer<T>::getWrittenCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return writtenCount;
+}
+
+template<typename T>
+uint64_t Checkpointer<T>::getReplacedCount() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return replacedCount;
+}
+
+template class Checkpointer<float>;
+template class Checkpointer<double>;
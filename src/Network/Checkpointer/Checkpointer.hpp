@@ -0,0 +1,183 @@
+/*
+ * Checkpointer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef CHECKPOINTER_CHECKPOINTER_HPP_
+#define CHECKPOINTER_CHECKPOINTER_HPP_
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <cstdint>
+
+#include "../Network.hpp"
+
+/**
+ * Model files written in the background during a learning
+ *
+ * A snapshot copies the weights and the biases of the network in one of two preallocated
+ * buffers (see Network::copyParameters) and returns: a background thread writes the buffer
+ * as a model file, flushes it to the disk and renames it to its final name (a checkpoint is
+ * complete or absent after a crash), then removes the oldest checkpoints. A snapshot never
+ * waits for the disk: while a buffer is written, the other one takes the snapshots (a snapshot
+ * not yet written is replaced by the next one)
+ *
+ * The topology of the network should not be changed (pruning, loading) while the checkpointer
+ * is used
+ */
+template<typename T>
+class Checkpointer {
+protected:
+	/**
+	 * State of a buffer
+	 */
+	enum class BufferState {
+		FREE, FILLING, PENDING, WRITING
+	};
+
+	/**
+	 * Saved network (must outlive the checkpointer)
+	 */
+	const Network<T>& network;
+
+	/**
+	 * Start of the paths of the checkpoints (followed by the step and ".annm")
+	 */
+	std::string pathPrefix;
+
+	/**
+	 * Number of checkpoints kept (0: all)
+	 */
+	unsigned int keptCount;
+
+	/**
+	 * Weights and biases of the two buffers
+	 */
+	std::vector<T> parameters[2];
+
+	/**
+	 * Learning step of the snapshot of each buffer
+	 */
+	uint64_t steps[2];
+
+	/**
+	 * State of each buffer
+	 */
+	BufferState states[2];
+
+	/**
+	 * Paths of the checkpoints written, the oldest first
+	 */
+	std::deque<std::string> paths;
+
+	/**
+	 * Number of checkpoints written
+	 */
+	uint64_t writtenCount;
+
+	/**
+	 * Number of snapshots replaced before being written
+	 */
+	uint64_t replacedCount;
+
+	/**
+	 * Protect the state of the buffers and the counters
+	 */
+	mutable std::mutex mutex;
+
+	/**
+	 * Signal a change of the state of the buffers
+	 */
+	std::condition_variable condition;
+
+	/**
+	 * Writing thread has to stop (once the pending snapshot is written)
+	 */
+	bool stopping;
+
+	/**
+	 * Exception thrown by the writing thread
+	 */
+	std::exception_ptr error;
+
+	/**
+	 * Writing thread
+	 */
+	std::thread writer;
+
+protected:
+	/**
+	 * Loop of the writing thread
+	 */
+	void write();
+
+	/**
+	 * Write a buffer as a checkpoint and remove the oldest ones
+	 * @param buffer buffer index
+	 */
+	void writeCheckpoint(int buffer);
+
+	/**
+	 * Throw the exception of the writing thread (once)
+	 */
+	void checkError();
+
+public:
+	/**
+	 * Constructor: allocate the buffers and start the writing thread
+	 * @param network saved network (must outlive the checkpointer)
+	 * @param pathPrefix start of the paths of the checkpoints (followed by the step and ".annm")
+	 * @param keptCount number of checkpoints kept, the oldest are removed (0: all)
+	 * @throw logic_error if the network is not complete
+	 */
+	Checkpointer(const Network<T>& network, const std::string& pathPrefix, unsigned int keptCount = 3);
+
+	/**
+	 * Destructor (the pending snapshot is written, then the thread stops)
+	 */
+	~Checkpointer();
+
+	Checkpointer(const Checkpointer&) = delete;
+	Checkpointer& operator=(const Checkpointer&) = delete;
+
+	/**
+	 * Copy the weights and the biases of the network to be written in the background (between
+	 * two learnings: the network should not learn during the copy)
+	 * @param step learning step of the snapshot (in the name of the checkpoint)
+	 * @throw the exception thrown by the writing thread
+	 */
+	void snapshot(uint64_t step);
+
+	/**
+	 * Wait until the pending snapshots are written
+	 * @throw the exception thrown by the writing thread
+	 */
+	void wait();
+
+	/**
+	 * Get path of the last checkpoint written
+	 * @return path (empty if none)
+	 */
+	std::string getLastPath() const;
+
+	/**
+	 * Get number of checkpoints written
+	 * @return number of checkpoints
+	 */
+	uint64_t getWrittenCount() const;
+
+	/**
+	 * Get number of snapshots replaced by a newer one before being written
+	 * @return number of snapshots
+	 */
+	uint64_t getReplacedCount() const;
+};
+
+#endif /* CHECKPOINTER_CHECKPOINTER_HPP_ */
@@ -0,0 +1,113 @@
+/*
+ * Connection.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "Connection.hpp"
+
+Connection::Connection(ConnectionType t) {
+	type = t;
+	density = 1;
+	radius = 0;
+}
+
+Connection::Connection() : Connection(ConnectionType::FULL) {
+}
+
+Connection Connection::full() {
+	return Connection(ConnectionType::FULL);
+}
+
+Connection Connection::random(double density) {
+	if (!(density > 0 && density <= 1)) {
+		throw std::invalid_argument("The density should be in ]0, 1]");
+	}
+	Connection connection(ConnectionType::RANDOM);
+	connection.density = density;
+	return connection;
+}
+
+Connection Connection::local(unsigned int radius) {
+	Connection connection(ConnectionType::LOCAL);
+	connection.radius = radius;
+	return connection;
+}
+
+Connection Connection::adjacency(std::vector<std::vector<unsigned int>> lists) {
+	Connection connection(ConnectionType::ADJACENCY);
+	connection.lists = std::move(lists);
+	return connection;
+}
+
+ConnectionType Connection::getType() const {
+	return type;
+}
+
+void Connection::build(unsigned int neuralsCount, unsigned int inputsCount, std::mt19937_64& generator, std::vector<unsigned int>& rowOffsets, std::vector<unsigned int>& columns) const {
+	rowOffsets.clear();
+	columns.clear();
+	if (type == ConnectionType::FULL) {
+		return;
+	}
+	if (type == ConnectionType::ADJACENCY && lists.size() != neuralsCount) {
+		throw std::invalid_argument("The adjacency should have one list by neural");
+	}
+
+	// Same number of links for each random neural (at least one)
+	unsigned int linksByNeural = (unsigned int) std::max(1.0, std::round(density * inputsCount));
+	linksByNeural = std::min(linksByNeural, inputsCount);
+	std::vector<char> isLinked(inputsCount, 0);
+
+	rowOffsets.reserve((size_t) neuralsCount + 1);
+	rowOffsets.push_back(0);
+	for (unsigned int i = 0; i < neuralsCount; ++i) {
+		size_t first = columns.size();
+		switch (type) {
+		case ConnectionType::RANDOM:
+			// Floyd's sampling: linksByNeural distinct previous neurals
+			for (unsigned int j = inputsCount - linksByNeural; j < inputsCount; ++j) {
+				unsigned int c = std::uniform_int_distribution<unsigned int>(0, j)(generator);
+				if (isLinked[c]) {
+					c = j;
+				}
+				isLinked[c] = 1;
+				columns.push_back(c);
+			}
+			for (size_t p = first; p < columns.size(); ++p) {
+				isLinked[columns[p]] = 0;
+			}
+			break;
+		case ConnectionType::LOCAL: {
+			// Window centered on the relative position of the neural
+			long long center = (long long) (((double) i + 0.5) * inputsCount / neuralsCount);
+			long long begin = std::max(0LL, center - (long long) radius);
+			long long end = std::min((long long) inputsCount, center + (long long) radius + 1);
+			for (long long c = begin; c < end; ++c) {
+				columns.push_back((unsigned int) c);
+			}
+			break;
+		}
+		case ConnectionType::ADJACENCY:
+			for (unsigned int c : lists[i]) {
+				if (c >= inputsCount) {
+					throw std::invalid_argument("The adjacency links a neural which is not in the previous layer");
+				}
+				columns.push_back(c);
+			}
+			break;
+		case ConnectionType::FULL:
+			break;
+		}
+
+		// Sorted links without duplicates (sequential reads of the previous values)
+		std::sort(columns.begin() + first, columns.end());
+		columns.erase(std::unique(columns.begin() + first, columns.end()), columns.end());
+		rowOffsets.push_back((unsigned int) columns.size());
+	}
+}
@@ -0,0 +1,106 @@
+/*
+ * Connection.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef CONNECTION_CONNECTION_HPP_
+#define CONNECTION_CONNECTION_HPP_
+
+#include <vector>
+#include <random>
+
+#include "../../constant.h"
+
+/**
+ * Links of a layer with the previous one
+ *
+ * Every neural of the previous layer (dense weights), a random subset of a given density,
+ * a window of neighbours (the neurals of the previous layer around the relative position of
+ * the neural) or explicit adjacency lists; the sparse connections are stored in compressed
+ * sparse rows (the links of a neural are contiguous and sorted by previous neural)
+ */
+class Connection {
+protected:
+	/**
+	 * Connection type
+	 */
+	ConnectionType type;
+
+	/**
+	 * Fraction of the previous neurals linked to each neural (RANDOM)
+	 */
+	double density;
+
+	/**
+	 * Number of previous neurals on each side of the center of the window (LOCAL)
+	 */
+	unsigned int radius;
+
+	/**
+	 * Previous neurals linked to each neural (ADJACENCY)
+	 */
+	std::vector<std::vector<unsigned int>> lists;
+
+	/**
+	 * Constructor
+	 * @param t connection type
+	 */
+	explicit Connection(ConnectionType t);
+
+public:
+	/**
+	 * Constructor of a full connection
+	 */
+	Connection();
+
+	/**
+	 * Every neural linked to every neural of the previous layer
+	 * @return connection
+	 */
+	static Connection full();
+
+	/**
+	 * Each neural linked to a random subset of the previous layer (the same number of links
+	 * for each neural, at least one)
+	 * @param density fraction of the previous neurals linked to each neural, in ]0, 1]
+	 * @return connection
+	 * @throw invalid_argument if the density is not in ]0, 1]
+	 */
+	static Connection random(double density);
+
+	/**
+	 * Each neural linked to a window of 2 * radius + 1 neurals of the previous layer, centered
+	 * on the relative position of the neural (clipped at the borders)
+	 * @param radius number of previous neurals on each side of the center
+	 * @return connection
+	 */
+	static Connection local(unsigned int radius);
+
+	/**
+	 * Each neural linked to a list of neurals of the previous layer
+	 * @param lists previous neurals of each neural (one list by neural, duplicates are ignored)
+	 * @return connection
+	 */
+	static Connection adjacency(std::vector<std::vector<unsigned int>> lists);
+
+	/**
+	 * Get connection type
+	 * @return connection type
+	 */
+	ConnectionType getType() const;
+
+	/**
+	 * Build the compressed sparse rows of the links (nothing for a full connection)
+	 * @param neuralsCount number of neurals
+	 * @param inputsCount number of neurals of the previous layer
+	 * @param generator random generator of the network (RANDOM)
+	 * @param rowOffsets first link of each neural (neuralsCount + 1)
+	 * @param columns previous neural of each link
+	 * @throw invalid_argument if the lists do not match the layers
+	 */
+	void build(unsigned int neuralsCount, unsigned int inputsCount, std::mt19937_64& generator, std::vector<unsigned int>& rowOffsets, std::vector<unsigned int>& columns) const;
+};
+
+#endif /* CONNECTION_CONNECTION_HPP_ */
@@ -0,0 +1,106 @@
+/*
+ * Dataset.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <fstream>
+#include <cstring>
+
+#include "Dataset.hpp"
+#include "../Model/Model.hpp"
+
+// "ANND"
+static const uint32_t DATASET_MAGIC = 0x444E4E41;
+
+// Version written by this code
+static const uint32_t DATASET_VERSION = 1;
+
+template<typename T>
+Dataset<T>::Dataset(const std::string& path) {
+	mappedFile = std::make_unique<MappedFile>(path);
+	const unsigned char* bytes = mappedFile->data();
+	uint64_t size = mappedFile->getSize();
+	auto check = [&](bool condition, const char* reason) {
+		if (!condition) {
+			throw std::runtime_error("Invalid dataset " + path + ": " + reason);
+		}
+	};
+
+	// Check the header
+	Header header;
+	check(size >= sizeof(header), "truncated header");
+	std::memcpy(&header, bytes, sizeof(header));
+	check(header.magic == DATASET_MAGIC, "not a dataset file");
+	check(header.version <= DATASET_VERSION, "unsupported version");
+	check(header.scalarSize == sizeof(T), "scalar type does not match");
+	check(header.fileSize == size, "truncated file");
+	check(header.rowsOffset % Model::ALIGNMENT == 0 && header.rowSize % Model::ALIGNMENT == 0, "unaligned rows");
+	check(header.rowSize >= ((uint64_t) header.inputsCount + header.outputsCount) * sizeof(T), "rows are too small");
+	check(header.rowsOffset <= size && (header.rowSize == 0 || header.samplesCount <= (size - header.rowsOffset) / header.rowSize), "truncated rows");
+
+	samplesCount = (size_t) header.samplesCount;
+	inputsCount = header.inputsCount;
+	outputsCount = header.outputsCount;
+	rowSize = (size_t) header.rowSize;
+	rows = bytes + header.rowsOffset;
+}
+
+template<typename T>
+void Dataset<T>::write(const std::string& path, const Matrix<T>& inputValues, const Matrix<T>& expectedValues) {
+	if (inputValues.getRowsCount() != expectedValues.getRowsCount()) {
+		throw std::invalid_argument("The input and expected values matrix should have the same number of rows");
+	}
+
+	// Header
+	Header header = Header();
+	header.magic = DATASET_MAGIC;
+	header.version = DATASET_VERSION;
+	header.scalarSize = sizeof(T);
+	header.inputsCount = (uint32_t) inputValues.getColsCount();
+	header.outputsCount = (uint32_t) expectedValues.getColsCount();
+	header.samplesCount = inputValues.getRowsCount();
+	header.rowSize = Model::align(((uint64_t) header.inputsCount + header.outputsCount) * sizeof(T));
+	header.rowsOffset = Model::align(sizeof(Header));
+	header.fileSize = header.rowsOffset + header.samplesCount * header.rowSize;
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Can not open " + path);
+	}
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+	// Rows padded with zeros
+	std::vector<unsigned char> row((size_t) header.rowSize, 0);
+	size_t inputsBytes = header.inputsCount * sizeof(T);
+	size_t expectedBytes = header.outputsCount * sizeof(T);
+	for (size_t r = 0; r < inputValues.getRowsCount(); ++r) {
+		std::memcpy(row.data(), inputValues.row(r), inputsBytes);
+		std::memcpy(row.data() + inputsBytes, expectedValues.row(r), expectedBytes);
+		file.write(reinterpret_cast<const char*>(row.data()), row.size());
+	}
+	file.close();
+	if (!file) {
+		throw std::runtime_error("Can not write " + path);
+	}
+}
+
+template<typename T>
+size_t Dataset<T>::getSamplesCount() const {
+	return samplesCount;
+}
+
+template<typename T>
+unsigned int Dataset<T>::getInputsCount() const {
+	return inputsCount;
+}
+
+template<typename T>
+unsigned int Dataset<T>::getOutputsCount() const {
+	return outputsCount;
+}
+
+template class Dataset<float>;
+template class Dataset<double>;
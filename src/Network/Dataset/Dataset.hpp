@@ -0,0 +1,137 @@
+/*
+ * Dataset.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef DATASET_DATASET_HPP_
+#define DATASET_DATASET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <memory>
+
+#include "../Matrix/Matrix.hpp"
+#include "../MappedFile/MappedFile.hpp"
+
+/**
+ * Binary dataset file mapped in memory (native byte order)
+ *
+ *  - Header
+ *  - One row by sample from rowsOffset: input values then expected values, each row
+ *    starts on a multiple of Model::ALIGNMENT
+ *
+ * The samples are read in place in the mapping (the pages are loaded on the first access)
+ */
+template<typename T>
+class Dataset {
+public:
+	/**
+	 * File header
+	 */
+	struct Header {
+		// "ANND"
+		uint32_t magic;
+		uint32_t version;
+
+		// Size of a value (4: float, 8: double)
+		uint32_t scalarSize;
+		uint32_t inputsCount;
+		uint32_t outputsCount;
+		uint32_t reserved0;
+		uint64_t samplesCount;
+
+		// Bytes between two rows, offset of the first row and total size of the file
+		uint64_t rowSize;
+		uint64_t rowsOffset;
+		uint64_t fileSize;
+		uint64_t reserved;
+	};
+
+	static_assert(sizeof(Header) == 64, "Dataset header must be 64 bytes");
+
+protected:
+	/**
+	 * Mapped file
+	 */
+	std::unique_ptr<MappedFile> mappedFile;
+
+	/**
+	 * Number of samples
+	 */
+	size_t samplesCount;
+
+	/**
+	 * Number of input values by sample
+	 */
+	unsigned int inputsCount;
+
+	/**
+	 * Number of expected values by sample
+	 */
+	unsigned int outputsCount;
+
+	/**
+	 * Bytes between two rows
+	 */
+	size_t rowSize;
+
+	/**
+	 * First row
+	 */
+	const unsigned char* rows;
+
+public:
+	/**
+	 * Constructor: map a dataset file
+	 * @param path path of the file
+	 * @throw runtime_error if the file can not be mapped or is not a valid dataset
+	 */
+	Dataset(const std::string& path);
+
+	/**
+	 * Write a dataset file
+	 * @param path path of the file
+	 * @param inputValues input values (one row by sample)
+	 * @param expectedValues expected values (one row by sample)
+	 * @throw invalid_argument if the matrix have not the same number of rows
+	 * @throw runtime_error if the file can not be written
+	 */
+	static void write(const std::string& path, const Matrix<T>& inputValues, const Matrix<T>& expectedValues);
+
+	/**
+	 * Get number of samples
+	 * @return number of samples
+	 */
+	size_t getSamplesCount() const;
+
+	/**
+	 * Get number of input values by sample
+	 * @return number of input values
+	 */
+	unsigned int getInputsCount() const;
+
+	/**
+	 * Get number of expected values by sample
+	 * @return number of expected values
+	 */
+	unsigned int getOutputsCount() const;
+
+	/**
+	 * Get input values of a sample
+	 * @param i sample index
+	 * @return input values (inputsCount)
+	 */
+	const T* getInputValues(size_t i) const { return reinterpret_cast<const T*>(rows + i * rowSize); }
+
+	/**
+	 * Get expected values of a sample
+	 * @param i sample index
+	 * @return expected values (outputsCount)
+	 */
+	const T* getExpectedValues(size_t i) const { return getInputValues(i) + inputsCount; }
+};
+
+#endif /* DATASET_DATASET_HPP_ */
@@ -0,0 +1,148 @@
+/*
+ * DatasetReader.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <numeric>
+
+#include "DatasetReader.hpp"
+
+template<typename T>
+DatasetReader<T>::DatasetReader(const Dataset<T>& dataset, size_t batchSize, bool shuffle, uint64_t seed): dataset(dataset), generator(seed) {
+	if (dataset.getSamplesCount() == 0) {
+		throw std::invalid_argument("The dataset should not be empty");
+	}
+	if (batchSize == 0) {
+		throw std::invalid_argument("The batch size should not be 0");
+	}
+
+	this->batchSize = std::min(batchSize, dataset.getSamplesCount());
+	this->shuffle = shuffle;
+	permutation.resize(dataset.getSamplesCount());
+	std::iota(permutation.begin(), permutation.end(), (size_t) 0);
+	position = 0;
+
+	// Buffers allocated once (the last mini-batch of an epoch only shrinks them)
+	for (int i = 0; i < 2; ++i) {
+		inputValues[i].resize(this->batchSize, dataset.getInputsCount());
+		expectedValues[i].resize(this->batchSize, dataset.getOutputsCount());
+		ready[i] = false;
+	}
+	current = -1;
+	producedCount = 0;
+	consumedCount = 0;
+	stopping = false;
+
+	prefetcher = std::thread(&DatasetReader<T>::prefetch, this);
+}
+
+template<typename T>
+DatasetReader<T>::~DatasetReader() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	condition.notify_all();
+	prefetcher.join();
+}
+
+template<typename T>
+void DatasetReader<T>::prefetch() {
+	try {
+		while (true) {
+			// Wait for a free buffer
+			int buffer;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				buffer = (int) (producedCount % 2);
+				condition.wait(lock, [&] { return stopping || (!ready[buffer] && current != buffer); });
+				if (stopping) {
+					return;
+				}
+			}
+
+			fill(buffer);
+
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				ready[buffer] = true;
+				++producedCount;
+			}
+			condition.notify_all();
+		}
+	} catch (...) {
+		std::lock_guard<std::mutex> lock(mutex);
+		error = std::current_exception();
+		condition.notify_all();
+	}
+}
+
+template<typename T>
+void DatasetReader<T>::fill(int buffer) {
+	// New permutation at the start of each epoch
+	if (position == 0 && shuffle) {
+		std::shuffle(permutation.begin(), permutation.end(), generator);
+	}
+
+	// Gather the samples of the mini-batch
+	size_t count = std::min(batchSize, permutation.size() - position);
+	size_t inputsCount = dataset.getInputsCount();
+	size_t outputsCount = dataset.getOutputsCount();
+	Matrix<T>& inputs = inputValues[buffer];
+	Matrix<T>& expected = expectedValues[buffer];
+	inputs.resize(count, inputsCount);
+	expected.resize(count, outputsCount);
+	for (size_t r = 0; r < count; ++r) {
+		size_t sample = permutation[position + r];
+		std::copy(dataset.getInputValues(sample), dataset.getInputValues(sample) + inputsCount, inputs.row(r));
+		std::copy(dataset.getExpectedValues(sample), dataset.getExpectedValues(sample) + outputsCount, expected.row(r));
+	}
+
+	position += count;
+	if (position == permutation.size()) {
+		position = 0;
+	}
+}
+
+template<typename T>
+size_t DatasetReader<T>::getBatchesCount() const {
+	return (dataset.getSamplesCount() + batchSize - 1) / batchSize;
+}
+
+template<typename T>
+void DatasetReader<T>::next() {
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		// Give back the current buffer
+		current = -1;
+		condition.notify_all();
+
+		// Wait for the next one (only if the prefetching thread is late)
+		int buffer = (int) (consumedCount % 2);
+		condition.wait(lock, [&] { return ready[buffer] || error; });
+		if (error) {
+			std::rethrow_exception(error);
+		}
+		ready[buffer] = false;
+		current = buffer;
+		++consumedCount;
+	}
+}
+
+template<typename T>
+const Matrix<T>& DatasetReader<T>::getInputValues() const {
+	return inputValues[current < 0 ? 0 : current];
+}
+
+template<typename T>
+const Matrix<T>& DatasetReader<T>::getExpectedValues() const {
+	return expectedValues[current < 0 ? 0 : current];
+}
+
+template class DatasetReader<float>;
+template class DatasetReader<double>;
@@ -0,0 +1,175 @@
+/*
+ * DatasetReader.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef DATASETREADER_DATASETREADER_HPP_
+#define DATASETREADER_DATASETREADER_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <random>
+#include <cstdint>
+
+#include "../Matrix/Matrix.hpp"
+#include "../Dataset/Dataset.hpp"
+
+/**
+ * Reader of mini-batches of a dataset in the order of a permutation of the samples
+ * (shuffled at each epoch)
+ *
+ * A background thread gathers the next mini-batch in one of two preallocated aligned buffers
+ * while the current one is used: the reads of the mapping (and the page faults) are done
+ * outside the learning thread and no memory is allocated after the construction
+ */
+template<typename T>
+class DatasetReader {
+protected:
+	/**
+	 * Dataset (must outlive the reader)
+	 */
+	const Dataset<T>& dataset;
+
+	/**
+	 * Number of samples by mini-batch (the last mini-batch of an epoch can be smaller)
+	 */
+	size_t batchSize;
+
+	/**
+	 * Shuffle the samples at each epoch
+	 */
+	bool shuffle;
+
+	/**
+	 * Random generator of the permutations
+	 */
+	std::mt19937_64 generator;
+
+	/**
+	 * Order of the samples of the current epoch (used by the prefetching thread only)
+	 */
+	std::vector<size_t> permutation;
+
+	/**
+	 * Position of the next sample in the permutation (used by the prefetching thread only)
+	 */
+	size_t position;
+
+	/**
+	 * Input values of the two buffers
+	 */
+	Matrix<T> inputValues[2];
+
+	/**
+	 * Expected values of the two buffers
+	 */
+	Matrix<T> expectedValues[2];
+
+	/**
+	 * Buffer filled and not yet taken
+	 */
+	bool ready[2];
+
+	/**
+	 * Buffer used by the caller (-1 for none)
+	 */
+	int current;
+
+	/**
+	 * Number of mini-batches filled
+	 */
+	size_t producedCount;
+
+	/**
+	 * Number of mini-batches taken
+	 */
+	size_t consumedCount;
+
+	/**
+	 * Protect the state of the buffers
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Signal a change of the state of the buffers
+	 */
+	std::condition_variable condition;
+
+	/**
+	 * Prefetching thread has to stop
+	 */
+	bool stopping;
+
+	/**
+	 * Exception thrown by the prefetching thread
+	 */
+	std::exception_ptr error;
+
+	/**
+	 * Prefetching thread
+	 */
+	std::thread prefetcher;
+
+protected:
+	/**
+	 * Loop of the prefetching thread
+	 */
+	void prefetch();
+
+	/**
+	 * Gather the next mini-batch of the permutation
+	 * @param buffer buffer index
+	 */
+	void fill(int buffer);
+
+public:
+	/**
+	 * Constructor: start prefetching the first mini-batch
+	 * @param dataset dataset (must outlive the reader)
+	 * @param batchSize number of samples by mini-batch
+	 * @param shuffle shuffle the samples at each epoch
+	 * @param seed seed of the permutations
+	 * @throw invalid_argument if the dataset is empty or the batch size is 0
+	 */
+	DatasetReader(const Dataset<T>& dataset, size_t batchSize, bool shuffle = true, uint64_t seed = 0);
+
+	/**
+	 * Destructor (stop the prefetching thread)
+	 */
+	~DatasetReader();
+
+	DatasetReader(const DatasetReader&) = delete;
+	DatasetReader& operator=(const DatasetReader&) = delete;
+
+	/**
+	 * Get number of mini-batches by epoch
+	 * @return number of mini-batches
+	 */
+	size_t getBatchesCount() const;
+
+	/**
+	 * Take the next mini-batch (the previous one is given back to the prefetching thread),
+	 * the epochs follow each other
+	 * @throw the exception thrown by the prefetching thread
+	 */
+	void next();
+
+	/**
+	 * Get input values of the current mini-batch
+	 * @return input values (one row by sample)
+	 */
+	const Matrix<T>& getInputValues() const;
+
+	/**
+	 * Get expected values of the current mini-batch
+	 * @return expected values (one row by sample)
+	 */
+	const Matrix<T>& getExpectedValues() const;
+};
+
+#endif /* DATASETREADER_DATASETREADER_HPP_ */
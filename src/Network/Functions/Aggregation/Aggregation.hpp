@@ -8,15 +8,33 @@
 #ifndef AGGREGATION_AGGREGATION_HPP_
 #define AGGREGATION_AGGREGATION_HPP_
 
-#include <vector>
-
-#include "../../Link/Link.hpp"
-
-class Link;
+#include <cstddef>
 
+template<typename T>
 class Aggregation {
 public:
-	virtual double compute(const std::vector<std::shared_ptr<Link>>& inputLinks) = 0;
+	virtual ~Aggregation() = default;
+
+	/**
+	 * Compute the aggregation of a whole layer
+	 * @param weights row-major weight matrix (outputsCount x inputsCount)
+	 * @param inputs values of the previous layer (inputsCount)
+	 * @param outputs aggregated values (outputsCount)
+	 * @param outputsCount number of neurals of the layer
+	 * @param inputsCount number of neurals of the previous layer
+	 */
+	virtual void compute(const T* weights, const T* inputs, T* outputs, size_t outputsCount, size_t inputsCount) = 0;
+
+	/**
+	 * Compute the aggregation of a whole layer for a batch of samples
+	 * @param weights row-major weight matrix (outputsCount x inputsCount)
+	 * @param inputs row-major values of the previous layer (batchSize x inputsCount)
+	 * @param outputs row-major aggregated values (batchSize x outputsCount)
+	 * @param batchSize number of samples
+	 * @param outputsCount number of neurals of the layer
+	 * @param inputsCount number of neurals of the previous layer
+	 */
+	virtual void computeBatch(const T* weights, const T* inputs, T* outputs, size_t batchSize, size_t outputsCount, size_t inputsCount) = 0;
 };
 
 #endif /* AGGREGATION_AGGREGATION_HPP_ */
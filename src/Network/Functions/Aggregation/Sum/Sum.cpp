@@ -6,14 +6,22 @@
  */
 
 #include "Sum.hpp"
+#include "../../../Kernel/Kernel.hpp"
 
-Sum::Sum(): Aggregation() {}
+template<typename T>
+Sum<T>::Sum(): Aggregation<T>() {}
 
-double Sum::compute(const std::vector<std::shared_ptr<Link>>& inputLinks) {
-	double sum = 0.0;
-	for (size_t i = 0; i < inputLinks.size(); ++i) {
-		sum += inputLinks.at(i)->getComputedValue();
-	}
-	return sum;
+template<typename T>
+void Sum<T>::compute(const T* weights, const T* inputs, T* outputs, size_t outputsCount, size_t inputsCount) {
+	// outputs = W * inputs
+	Kernel::gemv<T>(outputsCount, inputsCount, 1, weights, inputsCount, inputs, 0, outputs);
 }
 
+template<typename T>
+void Sum<T>::computeBatch(const T* weights, const T* inputs, T* outputs, size_t batchSize, size_t outputsCount, size_t inputsCount) {
+	// outputs = inputs * W'
+	Kernel::gemm<T>(Kernel::Transpose::NO_TRANS, Kernel::Transpose::TRANS, batchSize, outputsCount, inputsCount, 1, inputs, inputsCount, weights, inputsCount, 0, outputs, outputsCount);
+}
+
+template class Sum<float>;
+template class Sum<double>;
@@ -10,10 +10,12 @@
 
 #include "../Aggregation.hpp"
 
-class Sum: public Aggregation {
+template<typename T>
+class Sum: public Aggregation<T> {
 public:
 	Sum();
-	virtual double compute(const std::vector<std::shared_ptr<Link>>& inputLinks) override;
+	virtual void compute(const T* weights, const T* inputs, T* outputs, size_t outputsCount, size_t inputsCount) override;
+	virtual void computeBatch(const T* weights, const T* inputs, T* outputs, size_t batchSize, size_t outputsCount, size_t inputsCount) override;
 };
 
 #endif /* SUM_SUM_HPP_ */
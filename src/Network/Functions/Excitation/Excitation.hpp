@@ -8,10 +8,39 @@
 #ifndef EXCITATION_EXCITATION_HPP_
 #define EXCITATION_EXCITATION_HPP_
 
+#include <cstddef>
+
+template<typename T>
 class Excitation {
 public:
-	virtual double compute(double x) = 0;
-	virtual double derivative(double x) = 0;
+	virtual ~Excitation() = default;
+
+	virtual T compute(T x) = 0;
+	virtual T derivative(T x) = 0;
+
+	/**
+	 * Compute the excitation of a whole layer (one call instead of one by neural)
+	 * @param x input values
+	 * @param y output values (can be x)
+	 * @param count number of values
+	 */
+	virtual void computeBatch(const T* x, T* y, size_t count) {
+		for (size_t i = 0; i < count; ++i) {
+			y[i] = compute(x[i]);
+		}
+	}
+
+	/**
+	 * Compute the derivative of a whole layer (one call instead of one by neural)
+	 * @param x input values
+	 * @param y derivatives (can be x)
+	 * @param count number of values
+	 */
+	virtual void derivativeBatch(const T* x, T* y, size_t count) {
+		for (size_t i = 0; i < count; ++i) {
+			y[i] = derivative(x[i]);
+		}
+	}
 };
 
 #endif /* EXCITATION_EXCITATION_HPP_ */
@@ -0,0 +1,385 @@
+/*
+ * ExcitationKernel.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef EXCITATION_EXCITATIONKERNEL_HPP_
+#define EXCITATION_EXCITATIONKERNEL_HPP_
+
+#include <cstddef>
+#include <cmath>
+
+#include "../../../constant.h"
+#include "../../Simd/Simd.hpp"
+
+/**
+ * Excitations resolved at compile time
+ *
+ * Function<E, T> gives the inline scalar and vector forms of an excitation, the loops are
+ * instantiated once by excitation type: the type is dispatched once by call (one call by
+ * layer) and the excitation is inlined in the loop (no virtual call, vectorized)
+ */
+namespace ExcitationKernel {
+
+	/**
+	 * compute(x) and derivative(x) of an excitation, derivative(x, y) is the derivative
+	 * from x and y = f(x) without any transcendental function
+	 */
+	template<ExcitationType E, typename T>
+	struct Function;
+
+	template<typename T>
+	struct Function<ExcitationType::NO_EXC, T> {
+		typedef Simd::Vec<T> V;
+		static T compute(T x) { return x; }
+		static typename V::type computeVec(typename V::type x) { return x; }
+		static T derivative(T) { return 1; }
+		static typename V::type derivativeVec(typename V::type) { return V::set1(1); }
+		static T derivative(T, T) { return 1; }
+		static typename V::type derivativeVec(typename V::type, typename V::type) { return V::set1(1); }
+	};
+
+	template<typename T>
+	struct Function<ExcitationType::SIGMOID, T> {
+		typedef Simd::Vec<T> V;
+		static T compute(T x) { return 1 / (1 + std::exp(-x)); }
+		static typename V::type computeVec(typename V::type x) {
+			const typename V::type one = V::set1(1);
+			return V::div(one, V::add(one, V::exp(V::sub(V::zero(), x))));
+		}
+
+		// f'(x) = f(x) * (1 - f(x)), one exponential by value (none if f(x) is known)
+		static T derivative(T x) { return derivative(x, compute(x)); }
+		static typename V::type derivativeVec(typename V::type x) { return derivativeVec(x, computeVec(x)); }
+		static T derivative(T, T y) { return y * (1 - y); }
+		static typename V::type derivativeVec(typename V::type, typename V::type y) { return V::mul(y, V::sub(V::set1(1), y)); }
+	};
+
+	template<typename T>
+	struct Function<ExcitationType::TAN_HYP, T> {
+		typedef Simd::Vec<T> V;
+
+		// (1 - exp(-2|x|)) / (1 + exp(-2|x|)) with the sign of x (no overflow for large x)
+		static T compute(T x) {
+			T emx = std::exp(-2 * std::fabs(x));
+			T fx = (1 - emx) / (1 + emx);
+			return x < 0 ? -fx : fx;
+		}
+		static typename V::type computeVec(typename V::type x) {
+			const typename V::type one = V::set1(1);
+			typename V::type e = V::exp(V::mul(V::set1(-2), V::abs(x)));
+			return V::copySign(V::div(V::sub(one, e), V::add(one, e)), x);
+		}
+
+		// f'(x) = 1 - f(x)^2, one exponential by value (none if f(x) is known)
+		static T derivative(T x) { return derivative(x, compute(x)); }
+		static typename V::type derivativeVec(typename V::type x) { return derivativeVec(x, computeVec(x)); }
+		static T derivative(T, T y) { return 1 - (y * y); }
+		static typename V::type derivativeVec(typename V::type, typename V::type y) { return V::sub(V::set1(1), V::mul(y, y)); }
+	};
+
+	template<typename T>
+	struct Function<ExcitationType::STEP, T> {
+		typedef Simd::Vec<T> V;
+		static T compute(T x) { return (x < 0 ? 0 : 1); }
+		static typename V::type computeVec(typename V::type x) { return V::selectLess(x, V::zero(), V::zero(), V::set1(1)); }
+		static T derivative(T x) { return (x != 0 ? 0 : 1); }
+		static typename V::type derivativeVec(typename V::type x) { return V::selectNotEqual(x, V::zero(), V::zero(), V::set1(1)); }
+		static T derivative(T x, T) { return derivative(x); }
+		static typename V::type derivativeVec(typename V::type x, typename V::type) { return derivativeVec(x); }
+	};
+
+	/**
+	 * y = f(x)
+	 * @param x input values
+	 * @param y output values (can be x)
+	 * @param count number of values
+	 */
+	template<ExcitationType E, typename T>
+	inline void compute(const T* x, T* y, size_t count) {
+		typedef Function<E, T> F;
+		typedef Simd::Vec<T> V;
+		size_t i = 0;
+		for (; i + V::width <= count; i += V::width) {
+			V::store(y + i, F::computeVec(V::load(x + i)));
+		}
+		for (; i < count; ++i) {
+			y[i] = F::compute(x[i]);
+		}
+	}
+
+	/**
+	 * y = f'(x)
+	 * @param x input values
+	 * @param y derivatives (can be x)
+	 * @param count number of values
+	 */
+	template<ExcitationType E, typename T>
+	inline void derivative(const T* x, T* y, size_t count) {
+		typedef Function<E, T> F;
+		typedef Simd::Vec<T> V;
+		size_t i = 0;
+		for (; i + V::width <= count; i += V::width) {
+			V::store(y + i, F::derivativeVec(V::load(x + i)));
+		}
+		for (; i < count; ++i) {
+			y[i] = F::derivative(x[i]);
+		}
+	}
+
+	/**
+	 * z = z + b, y = f(z) in one pass over the rows
+	 * @param biases biases (count)
+	 * @param z input values (rowsCount x count), the biases are added in place
+	 * @param y output values (rowsCount x count)
+	 * @param rowsCount number of rows
+	 * @param count number of values by row
+	 */
+	template<ExcitationType E, typename T>
+	inline void computeBiased(const T* biases, T* z, T* y, size_t rowsCount, size_t count) {
+		typedef Function<E, T> F;
+		typedef Simd::Vec<T> V;
+		for (size_t r = 0; r < rowsCount; ++r) {
+			T* zr = z + r * count;
+			T* yr = y + r * count;
+			size_t i = 0;
+			for (; i + V::width <= count; i += V::width) {
+				typename V::type v = V::add(V::load(zr + i), V::load(biases + i));
+				V::store(zr + i, v);
+				V::store(yr + i, F::computeVec(v));
+			}
+			for (; i < count; ++i) {
+				zr[i] += biases[i];
+				yr[i] = F::compute(zr[i]);
+			}
+		}
+	}
+
+	/**
+	 * z = z + b, y = f(z), dy = f'(z) in one pass over the rows (the derivatives are
+	 * computed from the outputs: the backward pass needs no other exponential)
+	 * @param biases biases (count)
+	 * @param z input values (rowsCount x count), the biases are added in place
+	 * @param y output values (rowsCount x count)
+	 * @param dy derivatives (rowsCount x count)
+	 * @param rowsCount number of rows
+	 * @param count number of values by row
+	 */
+	template<ExcitationType E, typename T>
+	inline void computeBiased(const T* biases, T* z, T* y, T* dy, size_t rowsCount, size_t count) {
+		typedef Function<E, T> F;
+		typedef Simd::Vec<T> V;
+		for (size_t r = 0; r < rowsCount; ++r) {
+			T* zr = z + r * count;
+			T* yr = y + r * count;
+			T* dyr = dy + r * count;
+			size_t i = 0;
+			for (; i + V::width <= count; i += V::width) {
+				typename V::type v = V::add(V::load(zr + i), V::load(biases + i));
+				typename V::type fv = F::computeVec(v);
+				V::store(zr + i, v);
+				V::store(yr + i, fv);
+				V::store(dyr + i, F::derivativeVec(v, fv));
+			}
+			for (; i < count; ++i) {
+				zr[i] += biases[i];
+				yr[i] = F::compute(zr[i]);
+				dyr[i] = F::derivative(zr[i], yr[i]);
+			}
+		}
+	}
+
+	/**
+	 * Softmax of a row y = exp(x - m) / sum(exp(x - m)), shifted by the max m of the row (no
+	 * overflow of the exponentials)
+	 * @param x input values
+	 * @param y output values (can be x)
+	 * @param count number of values (at least 1)
+	 * @return log(sum(exp(x))) of the row (log-sum-exp, without overflow)
+	 */
+	template<typename T>
+	inline T softmax(const T* x, T* y, size_t count) {
+		typedef Simd::Vec<T> V;
+
+		// Max of the row
+		size_t i = 0;
+		T m = x[0];
+		if (count >= V::width) {
+			typename V::type vm = V::load(x);
+			for (i = V::width; i + V::width <= count; i += V::width) {
+				vm = V::max(vm, V::load(x + i));
+			}
+			m = V::reduceMax(vm);
+		}
+		for (; i < count; ++i) {
+			m = (x[i] > m ? x[i] : m);
+		}
+
+		// Shifted exponentials and their sum
+		const typename V::type vm = V::set1(m);
+		typename V::type vs = V::zero();
+		for (i = 0; i + V::width <= count; i += V::width) {
+			typename V::type e = V::exp(V::sub(V::load(x + i), vm));
+			V::store(y + i, e);
+			vs = V::add(vs, e);
+		}
+		T sum = V::sum(vs);
+		for (; i < count; ++i) {
+			y[i] = std::exp(x[i] - m);
+			sum += y[i];
+		}
+
+		// Normalization
+		const typename V::type inverse = V::set1(1 / sum);
+		for (i = 0; i + V::width <= count; i += V::width) {
+			V::store(y + i, V::mul(V::load(y + i), inverse));
+		}
+		for (; i < count; ++i) {
+			y[i] /= sum;
+		}
+		return m + std::log(sum);
+	}
+
+	/**
+	 * z = z + b, y = softmax(z) by row and the diagonal of the Jacobian dy = y * (1 - y) (the
+	 * output deltas use the whole Jacobian, see Loss)
+	 * @param biases biases (count)
+	 * @param z input values (rowsCount x count), the biases are added in place
+	 * @param y output values (rowsCount x count)
+	 * @param dy derivatives (rowsCount x count, none if null)
+	 * @param rowsCount number of rows
+	 * @param count number of values by row
+	 */
+	template<typename T>
+	inline void softmaxBiased(const T* biases, T* z, T* y, T* dy, size_t rowsCount, size_t count) {
+		typedef Simd::Vec<T> V;
+		const typename V::type one = V::set1(1);
+		for (size_t r = 0; r < rowsCount; ++r) {
+			T* zr = z + r * count;
+			T* yr = y + r * count;
+			size_t i = 0;
+			for (; i + V::width <= count; i += V::width) {
+				V::store(zr + i, V::add(V::load(zr + i), V::load(biases + i)));
+			}
+			for (; i < count; ++i) {
+				zr[i] += biases[i];
+			}
+			softmax(zr, yr, count);
+			if (dy) {
+				T* dyr = dy + r * count;
+				for (i = 0; i + V::width <= count; i += V::width) {
+					typename V::type v = V::load(yr + i);
+					V::store(dyr + i, V::mul(v, V::sub(one, v)));
+				}
+				for (; i < count; ++i) {
+					dyr[i] = yr[i] * (1 - yr[i]);
+				}
+			}
+		}
+	}
+
+	/**
+	 * y = f(x) with the excitation type known at run time (one dispatch by call, x is one row)
+	 */
+	template<typename T>
+	inline void compute(ExcitationType eT, const T* x, T* y, size_t count) {
+		switch (eT) {
+		case ExcitationType::NO_EXC:
+			compute<ExcitationType::NO_EXC>(x, y, count);
+			break;
+		case ExcitationType::SIGMOID:
+			compute<ExcitationType::SIGMOID>(x, y, count);
+			break;
+		case ExcitationType::STEP:
+			compute<ExcitationType::STEP>(x, y, count);
+			break;
+		case ExcitationType::TAN_HYP:
+			compute<ExcitationType::TAN_HYP>(x, y, count);
+			break;
+		case ExcitationType::SOFTMAX:
+			softmax(x, y, count);
+			break;
+		}
+	}
+
+	/**
+	 * z = z + b, y = f(z) with the excitation type known at run time (one dispatch by call)
+	 */
+	template<typename T>
+	inline void computeBiased(ExcitationType eT, const T* biases, T* z, T* y, size_t rowsCount, size_t count) {
+		switch (eT) {
+		case ExcitationType::NO_EXC:
+			computeBiased<ExcitationType::NO_EXC>(biases, z, y, rowsCount, count);
+			break;
+		case ExcitationType::SIGMOID:
+			computeBiased<ExcitationType::SIGMOID>(biases, z, y, rowsCount, count);
+			break;
+		case ExcitationType::STEP:
+			computeBiased<ExcitationType::STEP>(biases, z, y, rowsCount, count);
+			break;
+		case ExcitationType::TAN_HYP:
+			computeBiased<ExcitationType::TAN_HYP>(biases, z, y, rowsCount, count);
+			break;
+		case ExcitationType::SOFTMAX:
+			softmaxBiased<T>(biases, z, y, nullptr, rowsCount, count);
+			break;
+		}
+	}
+
+	/**
+	 * z = z + b, y = f(z), dy = f'(z) with the excitation type known at run time (one dispatch by call)
+	 */
+	template<typename T>
+	inline void computeBiased(ExcitationType eT, const T* biases, T* z, T* y, T* dy, size_t rowsCount, size_t count) {
+		switch (eT) {
+		case ExcitationType::NO_EXC:
+			computeBiased<ExcitationType::NO_EXC>(biases, z, y, dy, rowsCount, count);
+			break;
+		case ExcitationType::SIGMOID:
+			computeBiased<ExcitationType::SIGMOID>(biases, z, y, dy, rowsCount, count);
+			break;
+		case ExcitationType::STEP:
+			computeBiased<ExcitationType::STEP>(biases, z, y, dy, rowsCount, count);
+			break;
+		case ExcitationType::TAN_HYP:
+			computeBiased<ExcitationType::TAN_HYP>(biases, z, y, dy, rowsCount, count);
+			break;
+		case ExcitationType::SOFTMAX:
+			softmaxBiased(biases, z, y, dy, rowsCount, count);
+			break;
+		}
+	}
+
+	/**
+	 * y = f'(x) with the excitation type known at run time (one dispatch by call, x is one row:
+	 * diagonal of the Jacobian for the softmax)
+	 */
+	template<typename T>
+	inline void derivative(ExcitationType eT, const T* x, T* y, size_t count) {
+		switch (eT) {
+		case ExcitationType::NO_EXC:
+			derivative<ExcitationType::NO_EXC>(x, y, count);
+			break;
+		case ExcitationType::SIGMOID:
+			derivative<ExcitationType::SIGMOID>(x, y, count);
+			break;
+		case ExcitationType::STEP:
+			derivative<ExcitationType::STEP>(x, y, count);
+			break;
+		case ExcitationType::TAN_HYP:
+			derivative<ExcitationType::TAN_HYP>(x, y, count);
+			break;
+		case ExcitationType::SOFTMAX:
+			softmax(x, y, count);
+			for (size_t i = 0; i < count; ++i) {
+				y[i] = y[i] * (1 - y[i]);
+			}
+			break;
+		}
+	}
+
+}
+
+#endif /* EXCITATION_EXCITATIONKERNEL_HPP_ */
@@ -5,19 +5,49 @@
  *      Author: Jean-François Erdelyi
  */
 
-#include <math.h>
+#include <cmath>
 
 #include "Sigmoid.hpp"
+#include "../ExcitationKernel.hpp"
 
-Sigmoid::Sigmoid(double lambda): Excitation() {
+template<typename T>
+Sigmoid<T>::Sigmoid(T lambda): Excitation<T>() {
 	this->lambda = lambda;
 }
 
-double Sigmoid::compute(double x) {
-	return 1 / (1 + exp(-(lambda * x)));
+template<typename T>
+T Sigmoid<T>::compute(T x) {
+	return ExcitationKernel::Function<ExcitationType::SIGMOID, T>::compute(lambda * x);
 }
 
-double Sigmoid::derivative(double x) {
-	double y = compute(x);
+template<typename T>
+T Sigmoid<T>::derivative(T x) {
+	T y = compute(x);
 	return y * (1 - y);
 }
+
+template<typename T>
+void Sigmoid<T>::computeBatch(const T* x, T* y, size_t count) {
+	typedef Simd::Vec<T> V;
+	typedef ExcitationKernel::Function<ExcitationType::SIGMOID, T> F;
+	const typename V::type vlambda = V::set1(lambda);
+	size_t i = 0;
+	for (; i + V::width <= count; i += V::width) {
+		V::store(y + i, F::computeVec(V::mul(vlambda, V::load(x + i))));
+	}
+	for (; i < count; ++i) {
+		y[i] = compute(x[i]);
+	}
+}
+
+template<typename T>
+void Sigmoid<T>::derivativeBatch(const T* x, T* y, size_t count) {
+	// f'(x) = f(x) * (1 - f(x)), one exponential by value
+	computeBatch(x, y, count);
+	for (size_t i = 0; i < count; ++i) {
+		y[i] = y[i] * (1 - y[i]);
+	}
+}
+
+template class Sigmoid<float>;
+template class Sigmoid<double>;
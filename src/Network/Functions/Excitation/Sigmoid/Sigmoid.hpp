@@ -10,14 +10,17 @@
 
 #include "../Excitation.hpp"
 
-class Sigmoid: public Excitation {
+template<typename T>
+class Sigmoid: public Excitation<T> {
 protected:
-	double lambda;
+	T lambda;
 
 public:
-	Sigmoid(double lambda = 1.0);
-	virtual double compute(double x) override;
-	virtual double derivative(double x) override;
+	Sigmoid(T lambda = 1);
+	virtual T compute(T x) override;
+	virtual T derivative(T x) override;
+	virtual void computeBatch(const T* x, T* y, size_t count) override;
+	virtual void derivativeBatch(const T* x, T* y, size_t count) override;
 };
 
 #endif /* SIGMOID_SIGMOID_HPP_ */
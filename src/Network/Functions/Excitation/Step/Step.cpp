@@ -6,14 +6,30 @@
  */
 
 #include "Step.hpp"
+#include "../ExcitationKernel.hpp"
 
-Step::Step(): Excitation() {}
+template<typename T>
+Step<T>::Step(): Excitation<T>() {}
 
-double Step::compute(double x) {
-	return (x < 0.0 ? 0.0 : 1.0);
+template<typename T>
+T Step<T>::compute(T x) {
+	return ExcitationKernel::Function<ExcitationType::STEP, T>::compute(x);
 }
 
-double Step::derivative(double x) {
-	return (x != 0.0 ? 0.0 : 1.0);
+template<typename T>
+T Step<T>::derivative(T x) {
+	return ExcitationKernel::Function<ExcitationType::STEP, T>::derivative(x);
 }
 
+template<typename T>
+void Step<T>::computeBatch(const T* x, T* y, size_t count) {
+	ExcitationKernel::compute<ExcitationType::STEP>(x, y, count);
+}
+
+template<typename T>
+void Step<T>::derivativeBatch(const T* x, T* y, size_t count) {
+	ExcitationKernel::derivative<ExcitationType::STEP>(x, y, count);
+}
+
+template class Step<float>;
+template class Step<double>;
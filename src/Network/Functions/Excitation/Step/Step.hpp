@@ -10,11 +10,14 @@
 
 #include "../Excitation.hpp"
 
-class Step: public Excitation {
+template<typename T>
+class Step: public Excitation<T> {
 public:
 	Step();
-	virtual double compute(double x) override;
-	virtual double derivative(double x) override;
+	virtual T compute(T x) override;
+	virtual T derivative(T x) override;
+	virtual void computeBatch(const T* x, T* y, size_t count) override;
+	virtual void derivativeBatch(const T* x, T* y, size_t count) override;
 };
 
 #endif /* SRC_NETWORK_FUNCTIONS_EXCITATION_STEP_STEP_HPP_ */
@@ -5,19 +5,34 @@
  *      Author: Jean-François Erdelyi
  */
 
-#include <math.h>
+#include <cmath>
 
 #include "TanHyp.hpp"
+#include "../ExcitationKernel.hpp"
 
-TanHyp::TanHyp(): Excitation() {}
+template<typename T>
+TanHyp<T>::TanHyp(): Excitation<T>() {}
 
-double TanHyp::compute(double x) {
-	double epx = exp(x);
-	double emx = exp(-x);
-	return (epx - emx) / (epx + emx);
+template<typename T>
+T TanHyp<T>::compute(T x) {
+	return ExcitationKernel::Function<ExcitationType::TAN_HYP, T>::compute(x);
 }
 
-double TanHyp::derivative(double x) {
-	double fx = compute(x);
-	return 1 - (fx * fx);
+template<typename T>
+T TanHyp<T>::derivative(T x) {
+	return ExcitationKernel::Function<ExcitationType::TAN_HYP, T>::derivative(x);
 }
+
+template<typename T>
+void TanHyp<T>::computeBatch(const T* x, T* y, size_t count) {
+	ExcitationKernel::compute<ExcitationType::TAN_HYP>(x, y, count);
+}
+
+template<typename T>
+void TanHyp<T>::derivativeBatch(const T* x, T* y, size_t count) {
+	// f'(x) = 1 - f(x)^2, one exponential by value
+	ExcitationKernel::derivative<ExcitationType::TAN_HYP>(x, y, count);
+}
+
+template class TanHyp<float>;
+template class TanHyp<double>;
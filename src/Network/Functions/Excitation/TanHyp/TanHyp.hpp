@@ -10,11 +10,14 @@
 
 #include "../Excitation.hpp"
 
-class TanHyp: public Excitation {
+template<typename T>
+class TanHyp: public Excitation<T> {
 public:
 	TanHyp();
-	virtual double compute(double x) override;
-	virtual double derivative(double x) override;
+	virtual T compute(T x) override;
+	virtual T derivative(T x) override;
+	virtual void computeBatch(const T* x, T* y, size_t count) override;
+	virtual void derivativeBatch(const T* x, T* y, size_t count) override;
 };
 
 #endif /* SRC_NETWORK_FUNCTIONS_EXCITATION_TANHYP_TANHYP_HPP_ */
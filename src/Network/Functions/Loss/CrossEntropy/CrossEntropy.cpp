@@ -0,0 +1,69 @@
+/*
+ * CrossEntropy.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+
+#include "CrossEntropy.hpp"
+#include "../../Excitation/ExcitationKernel.hpp"
+#include "../../../Simd/Simd.hpp"
+
+template<typename T>
+T CrossEntropy<T>::compute(ExcitationType eT, const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) const {
+	if (eT != ExcitationType::SOFTMAX) {
+		throw std::logic_error("The cross-entropy loss needs a softmax output layer");
+	}
+
+	typedef Simd::Vec<T> V;
+	T sumLoss = 0;
+	for (size_t r = 0; r < rowsCount; ++r) {
+		T* z = inputs + r * count;
+		T* y = outputs + r * count;
+		T* d = deltas + r * count;
+		const T* expected = expectedValues + r * ldExpected;
+
+		// z = z + b, y = softmax(z) and log(sum(exp(z)))
+		size_t i = 0;
+		for (; i + V::width <= count; i += V::width) {
+			V::store(z + i, V::add(V::load(z + i), V::load(biases + i)));
+		}
+		for (; i < count; ++i) {
+			z[i] += biases[i];
+		}
+		T logSumExp = ExcitationKernel::softmax(z, y, count);
+
+		// -sum(expected * log(y)) = sum(expected) * logSumExp - sum(expected * z)
+		typename V::type vt = V::zero();
+		typename V::type vtz = V::zero();
+		for (i = 0; i + V::width <= count; i += V::width) {
+			typename V::type t = V::load(expected + i);
+			vt = V::add(vt, t);
+			vtz = V::fmadd(t, V::load(z + i), vtz);
+		}
+		T sumExpected = V::sum(vt);
+		T sumExpectedZ = V::sum(vtz);
+		for (; i < count; ++i) {
+			sumExpected += expected[i];
+			sumExpectedZ += expected[i] * z[i];
+		}
+		sumLoss += sumExpected * logSumExp - sumExpectedZ;
+
+		// delta = y * sum(expected) - expected
+		const typename V::type vs = V::set1(sumExpected);
+		for (i = 0; i + V::width <= count; i += V::width) {
+			V::store(d + i, V::sub(V::mul(V::load(y + i), vs), V::load(expected + i)));
+		}
+		for (; i < count; ++i) {
+			d[i] = y[i] * sumExpected - expected[i];
+		}
+	}
+
+	// Mean of the rows
+	return sumLoss / (T) rowsCount;
+}
+
+template class CrossEntropy<float>;
+template class CrossEntropy<double>;
@@ -0,0 +1,24 @@
+/*
+ * CrossEntropy.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef CROSSENTROPY_CROSSENTROPY_HPP_
+#define CROSSENTROPY_CROSSENTROPY_HPP_
+
+#include "../Loss.hpp"
+
+/**
+ * Cross-entropy of a softmax output layer: -sum(expected * log(y)) by row, computed from the
+ * log-sum-exp of z (no logarithm of a small output), deltas = y * sum(expected) - expected
+ * (y - expected for a distribution)
+ */
+template<typename T>
+class CrossEntropy : public Loss<T> {
+public:
+	T compute(ExcitationType eT, const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) const override;
+};
+
+#endif /* CROSSENTROPY_CROSSENTROPY_HPP_ */
@@ -8,11 +8,35 @@
 #ifndef LOSS_LOSS_HPP_
 #define LOSS_LOSS_HPP_
 
-#include <vector> 
+#include <cstddef>
 
+#include "../../../constant.h"
+
+/**
+ * Loss of the output layer, computed with the outputs and the deltas of the layer in one pass
+ * over each row (no separate errors)
+ */
+template<typename T>
 class Loss {
 public:
-	virtual double compute(const std::vector<double>& outputErrors) = 0;
+	virtual ~Loss() = default;
+
+	/**
+	 * Compute the outputs, the deltas and the loss of the output layer: z = z + b, y = f(z)
+	 * and deltas = dLoss / dz
+	 * @param eT excitation of the output layer
+	 * @param biases biases of the output layer (count)
+	 * @param inputs input values of the output layer (rowsCount x count), the biases are added in place
+	 * @param expectedValues expected values (rowsCount rows of ldExpected values)
+	 * @param ldExpected number of values by row of the expected values (at least count)
+	 * @param outputs output values (rowsCount x count)
+	 * @param deltas deltas of the output layer (rowsCount x count)
+	 * @param rowsCount number of rows
+	 * @param count number of output neurals
+	 * @return loss value (mean of the rows)
+	 * @throw logic_error if the excitation is not supported by the loss
+	 */
+	virtual T compute(ExcitationType eT, const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) const = 0;
 };
 
 #endif /* LOSS_LOSS_HPP_ */
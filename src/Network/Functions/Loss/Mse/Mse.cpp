@@ -6,17 +6,124 @@
  */
 
 #include "Mse.hpp"
+#include "../../Excitation/ExcitationKernel.hpp"
+#include "../../../Simd/Simd.hpp"
 
-double Mse::compute(const std::vector<double>& outputErrors) {
-	double sumSe = 0.0;
-	size_t outputCount = outputErrors.size();
+namespace {
 
-	// Compute the sum
-	for (size_t i = 0; i < outputCount; ++i) {
-		double error = outputErrors.at(i);
-		sumSe += error * error;
+	/**
+	 * Sum of the squared errors of the rows with an element-wise excitation (one dispatch by
+	 * call, the excitation is inlined in the loop)
+	 */
+	template<ExcitationType E, typename T>
+	T computeRows(const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) {
+		typedef ExcitationKernel::Function<E, T> F;
+		typedef Simd::Vec<T> V;
+		T sumSe = 0;
+		for (size_t r = 0; r < rowsCount; ++r) {
+			T* z = inputs + r * count;
+			T* y = outputs + r * count;
+			T* d = deltas + r * count;
+			const T* expected = expectedValues + r * ldExpected;
+
+			// z = z + b, y = f(z), error = y - expected, delta = error * f'(z)
+			typename V::type vs = V::zero();
+			size_t i = 0;
+			for (; i + V::width <= count; i += V::width) {
+				typename V::type v = V::add(V::load(z + i), V::load(biases + i));
+				typename V::type fv = F::computeVec(v);
+				typename V::type error = V::sub(fv, V::load(expected + i));
+				V::store(z + i, v);
+				V::store(y + i, fv);
+				V::store(d + i, V::mul(error, F::derivativeVec(v, fv)));
+				vs = V::fmadd(error, error, vs);
+			}
+			T s = V::sum(vs);
+			for (; i < count; ++i) {
+				z[i] += biases[i];
+				y[i] = F::compute(z[i]);
+				T error = y[i] - expected[i];
+				d[i] = error * F::derivative(z[i], y[i]);
+				s += error * error;
+			}
+			sumSe += s;
+		}
+		return sumSe;
+	}
+
+	/**
+	 * Sum of the squared errors of the rows with a softmax: delta = y * (error - sum(error * y))
+	 * (the Jacobian of the softmax is not diagonal)
+	 */
+	template<typename T>
+	T computeSoftmaxRows(const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) {
+		typedef Simd::Vec<T> V;
+		T sumSe = 0;
+		for (size_t r = 0; r < rowsCount; ++r) {
+			T* y = outputs + r * count;
+			T* d = deltas + r * count;
+			const T* expected = expectedValues + r * ldExpected;
+			ExcitationKernel::softmaxBiased<T>(biases, inputs + r * count, y, nullptr, 1, count);
+
+			// Errors (in the deltas), their squares and their products with the outputs
+			typename V::type vs = V::zero();
+			typename V::type vp = V::zero();
+			size_t i = 0;
+			for (; i + V::width <= count; i += V::width) {
+				typename V::type vy = V::load(y + i);
+				typename V::type error = V::sub(vy, V::load(expected + i));
+				V::store(d + i, error);
+				vs = V::fmadd(error, error, vs);
+				vp = V::fmadd(error, vy, vp);
+			}
+			T s = V::sum(vs);
+			T p = V::sum(vp);
+			for (; i < count; ++i) {
+				d[i] = y[i] - expected[i];
+				s += d[i] * d[i];
+				p += d[i] * y[i];
+			}
+			sumSe += s;
+
+			// delta = y * (error - p)
+			const typename V::type vpp = V::set1(p);
+			for (i = 0; i + V::width <= count; i += V::width) {
+				V::store(d + i, V::mul(V::load(y + i), V::sub(V::load(d + i), vpp)));
+			}
+			for (; i < count; ++i) {
+				d[i] = y[i] * (d[i] - p);
+			}
+		}
+		return sumSe;
 	}
 
-	// (1 / n) * sum(1..n)
-	return (1 / (double) outputCount) * sumSe;
 }
+
+template<typename T>
+T Mse<T>::compute(ExcitationType eT, const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) const {
+	// Compute the sum (one dispatch of the excitation for the rows)
+	T sumSe = 0;
+	switch (eT) {
+	case ExcitationType::NO_EXC:
+		sumSe = computeRows<ExcitationType::NO_EXC>(biases, inputs, expectedValues, ldExpected, outputs, deltas, rowsCount, count);
+		break;
+	case ExcitationType::SIGMOID:
+		sumSe = computeRows<ExcitationType::SIGMOID>(biases, inputs, expectedValues, ldExpected, outputs, deltas, rowsCount, count);
+		break;
+	case ExcitationType::STEP:
+		sumSe = computeRows<ExcitationType::STEP>(biases, inputs, expectedValues, ldExpected, outputs, deltas, rowsCount, count);
+		break;
+	case ExcitationType::TAN_HYP:
+		sumSe = computeRows<ExcitationType::TAN_HYP>(biases, inputs, expectedValues, ldExpected, outputs, deltas, rowsCount, count);
+		break;
+	case ExcitationType::SOFTMAX:
+		sumSe = computeSoftmaxRows(biases, inputs, expectedValues, ldExpected, outputs, deltas, rowsCount, count);
+		break;
+	}
+
+	// (1 / n) * sum(1..n) over the outputs of all the rows
+	return (1 / (T) (rowsCount * count)) * sumSe;
+}
+
+template class Mse<float>;
+template class Mse<double>;
@@ -10,8 +10,14 @@
 
 #include "../Loss.hpp"
 
-class Mse : public Loss {
-	double compute(const std::vector<double>& outputErrors) override;
+/**
+ * Mean squared error: mean of (y - expected)^2 over the outputs, deltas = (y - expected) * f'(z)
+ * (whole Jacobian of the softmax)
+ */
+template<typename T>
+class Mse : public Loss<T> {
+public:
+	T compute(ExcitationType eT, const T* biases, T* inputs, const T* expectedValues, size_t ldExpected, T* outputs, T* deltas, size_t rowsCount, size_t count) const override;
 };
 
 #endif /* MSE_MSE_HPP_ */
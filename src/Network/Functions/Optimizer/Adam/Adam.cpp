@@ -0,0 +1,81 @@
+/*
+ * Adam.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <cmath>
+
+#include "Adam.hpp"
+#include "../../../Simd/Simd.hpp"
+
+template<typename T>
+Adam<T>::Adam(T beta1, T beta2, T epsilon) {
+	this->beta1 = beta1;
+	this->beta2 = beta2;
+	this->epsilon = epsilon;
+	beta1Power = 1;
+	beta2Power = 1;
+	correction1 = 1;
+	correction2 = 1;
+}
+
+template<typename T>
+size_t Adam<T>::getStatesCount() const {
+	return 2;
+}
+
+template<typename T>
+void Adam<T>::reserve(size_t parametersCount) {
+	Optimizer<T>::reserve(parametersCount);
+
+	// The moments start again from zero
+	beta1Power = 1;
+	beta2Power = 1;
+}
+
+template<typename T>
+void Adam<T>::step() {
+	// Bias corrections of the moments (once by step, not by parameter)
+	beta1Power *= beta1;
+	beta2Power *= beta2;
+	correction1 = (T) (1 / (1 - beta1Power));
+	correction2 = (T) (1 / (1 - beta2Power));
+}
+
+template<typename T>
+void Adam<T>::update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) {
+	typedef Simd::Vec<T> V;
+	T* firstMoments = this->getState(0, offset);
+	T* secondMoments = this->getState(1, offset);
+
+	// m = b1 * m + (1 - b1) * g, v = b2 * v + (1 - b2) * g^2
+	// w = w - alpha * (m * c1) / (sqrt(v * c2) + epsilon)
+	const typename V::type vbeta1 = V::set1(beta1);
+	const typename V::type vbeta2 = V::set1(beta2);
+	const typename V::type vscale1 = V::set1((1 - beta1) * scale);
+	const typename V::type vscale2 = V::set1((1 - beta2) * scale * scale);
+	const typename V::type vrate = V::set1(learningRate * correction1);
+	const typename V::type vcorrection2 = V::set1(correction2);
+	const typename V::type vepsilon = V::set1(epsilon);
+	size_t i = 0;
+	for (; i + V::width <= count; i += V::width) {
+		typename V::type g = V::load(gradients + i);
+		typename V::type m = V::fmadd(vbeta1, V::load(firstMoments + i), V::mul(vscale1, g));
+		typename V::type v = V::fmadd(vbeta2, V::load(secondMoments + i), V::mul(vscale2, V::mul(g, g)));
+		V::store(firstMoments + i, m);
+		V::store(secondMoments + i, v);
+		typename V::type step = V::div(V::mul(vrate, m), V::add(V::sqrt(V::mul(vcorrection2, v)), vepsilon));
+		V::store(parameters + i, V::sub(V::load(parameters + i), step));
+	}
+	for (; i < count; ++i) {
+		T g = scale * gradients[i];
+		firstMoments[i] = beta1 * firstMoments[i] + (1 - beta1) * g;
+		secondMoments[i] = beta2 * secondMoments[i] + (1 - beta2) * g * g;
+		parameters[i] -= learningRate * correction1 * firstMoments[i] / (std::sqrt(correction2 * secondMoments[i]) + epsilon);
+	}
+}
+
+template class Adam<float>;
+template class Adam<double>;
@@ -0,0 +1,64 @@
+/*
+ * Adam.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef ADAM_ADAM_HPP_
+#define ADAM_ADAM_HPP_
+
+#include "../Optimizer.hpp"
+
+/**
+ * Adam: m = b1 * m + (1 - b1) * g, v = b2 * v + (1 - b2) * g^2,
+ * w = w - alpha * m / (1 - b1^t) / (sqrt(v / (1 - b2^t)) + epsilon)
+ *
+ * @link https://arxiv.org/abs/1412.6980
+ */
+template<typename T>
+class Adam : public Optimizer<T> {
+protected:
+	/**
+	 * Decay of the first moment
+	 */
+	T beta1;
+
+	/**
+	 * Decay of the second moment
+	 */
+	T beta2;
+
+	/**
+	 * Term added to the square root of the second moment
+	 */
+	T epsilon;
+
+	/**
+	 * beta1^t and beta2^t (t: number of steps)
+	 */
+	double beta1Power;
+	double beta2Power;
+
+	/**
+	 * Bias corrections of the current step 1 / (1 - beta1^t) and 1 / (1 - beta2^t)
+	 */
+	T correction1;
+	T correction2;
+
+public:
+	/**
+	 * Constructor
+	 * @param beta1 decay of the first moment [default = 0.9]
+	 * @param beta2 decay of the second moment [default = 0.999]
+	 * @param epsilon term added to the square root of the second moment [default = 1e-8]
+	 */
+	Adam(T beta1 = (T) 0.9, T beta2 = (T) 0.999, T epsilon = (T) 1e-8);
+
+	size_t getStatesCount() const override;
+	void reserve(size_t parametersCount) override;
+	void step() override;
+	void update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) override;
+};
+
+#endif /* ADAM_ADAM_HPP_ */
@@ -0,0 +1,43 @@
+/*
+ * Momentum.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Momentum.hpp"
+#include "../../../Simd/Simd.hpp"
+
+template<typename T>
+Momentum<T>::Momentum(T mu) {
+	this->mu = mu;
+}
+
+template<typename T>
+size_t Momentum<T>::getStatesCount() const {
+	return 1;
+}
+
+template<typename T>
+void Momentum<T>::update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) {
+	typedef Simd::Vec<T> V;
+	T* velocities = this->getState(0, offset);
+
+	// v = mu * v + g, w = w - alpha * v
+	const typename V::type vmu = V::set1(mu);
+	const typename V::type vscale = V::set1(scale);
+	const typename V::type vrate = V::set1(-learningRate);
+	size_t i = 0;
+	for (; i + V::width <= count; i += V::width) {
+		typename V::type v = V::fmadd(vmu, V::load(velocities + i), V::mul(vscale, V::load(gradients + i)));
+		V::store(velocities + i, v);
+		V::store(parameters + i, V::fmadd(vrate, v, V::load(parameters + i)));
+	}
+	for (; i < count; ++i) {
+		velocities[i] = mu * velocities[i] + scale * gradients[i];
+		parameters[i] -= learningRate * velocities[i];
+	}
+}
+
+template class Momentum<float>;
+template class Momentum<double>;
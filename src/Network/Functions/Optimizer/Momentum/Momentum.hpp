@@ -0,0 +1,35 @@
+/*
+ * Momentum.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef MOMENTUM_MOMENTUM_HPP_
+#define MOMENTUM_MOMENTUM_HPP_
+
+#include "../Optimizer.hpp"
+
+/**
+ * Gradient descent with momentum: v = mu * v + g, w = w - alpha * v
+ */
+template<typename T>
+class Momentum : public Optimizer<T> {
+protected:
+	/**
+	 * Momentum of the velocity
+	 */
+	T mu;
+
+public:
+	/**
+	 * Constructor
+	 * @param mu momentum of the velocity, between 0.0 and 1.0 [default = 0.9]
+	 */
+	Momentum(T mu = (T) 0.9);
+
+	size_t getStatesCount() const override;
+	void update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) override;
+};
+
+#endif /* MOMENTUM_MOMENTUM_HPP_ */
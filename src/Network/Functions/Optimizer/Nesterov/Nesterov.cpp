@@ -0,0 +1,45 @@
+/*
+ * Nesterov.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Nesterov.hpp"
+#include "../../../Simd/Simd.hpp"
+
+template<typename T>
+Nesterov<T>::Nesterov(T mu) {
+	this->mu = mu;
+}
+
+template<typename T>
+size_t Nesterov<T>::getStatesCount() const {
+	return 1;
+}
+
+template<typename T>
+void Nesterov<T>::update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) {
+	typedef Simd::Vec<T> V;
+	T* velocities = this->getState(0, offset);
+
+	// v = mu * v + g, w = w - alpha * (g + mu * v) (look-ahead of the velocity)
+	const typename V::type vmu = V::set1(mu);
+	const typename V::type vscale = V::set1(scale);
+	const typename V::type vrate = V::set1(-learningRate);
+	size_t i = 0;
+	for (; i + V::width <= count; i += V::width) {
+		typename V::type g = V::mul(vscale, V::load(gradients + i));
+		typename V::type v = V::fmadd(vmu, V::load(velocities + i), g);
+		V::store(velocities + i, v);
+		V::store(parameters + i, V::fmadd(vrate, V::fmadd(vmu, v, g), V::load(parameters + i)));
+	}
+	for (; i < count; ++i) {
+		T g = scale * gradients[i];
+		velocities[i] = mu * velocities[i] + g;
+		parameters[i] -= learningRate * (g + mu * velocities[i]);
+	}
+}
+
+template class Nesterov<float>;
+template class Nesterov<double>;
@@ -0,0 +1,35 @@
+/*
+ * Nesterov.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef NESTEROV_NESTEROV_HPP_
+#define NESTEROV_NESTEROV_HPP_
+
+#include "../Optimizer.hpp"
+
+/**
+ * Nesterov accelerated gradient: v = mu * v + g, w = w - alpha * (g + mu * v)
+ */
+template<typename T>
+class Nesterov : public Optimizer<T> {
+protected:
+	/**
+	 * Momentum of the velocity
+	 */
+	T mu;
+
+public:
+	/**
+	 * Constructor
+	 * @param mu momentum of the velocity, between 0.0 and 1.0 [default = 0.9]
+	 */
+	Nesterov(T mu = (T) 0.9);
+
+	size_t getStatesCount() const override;
+	void update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) override;
+};
+
+#endif /* NESTEROV_NESTEROV_HPP_ */
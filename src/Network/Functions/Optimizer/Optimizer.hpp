@@ -0,0 +1,83 @@
+/*
+ * Optimizer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef OPTIMIZER_OPTIMIZER_HPP_
+#define OPTIMIZER_OPTIMIZER_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "../../AlignedAllocator/AlignedAllocator.hpp"
+
+/**
+ * Update rule of the weights and the biases
+ *
+ * The state of the optimizer (velocities, moments) is one aligned array by kind of state,
+ * laid out as the parameters of the network: the state of a parameter is at the offset of
+ * the parameter in the weights and biases of all the layers, the update reads the gradients
+ * and writes the parameters and their state in one pass
+ */
+template<typename T>
+class Optimizer {
+protected:
+	/**
+	 * State arrays (getStatesCount() x parametersCount)
+	 */
+	std::vector<T, AlignedAllocator<T>> states;
+
+	/**
+	 * Number of parameters of the network (aligned arrays of every layer)
+	 */
+	size_t parametersCount = 0;
+
+	/**
+	 * Get the state of a parameter
+	 * @param i kind of state
+	 * @param offset offset of the parameter
+	 * @return first state value
+	 */
+	T* getState(size_t i, size_t offset) {
+		return states.data() + i * parametersCount + offset;
+	}
+
+public:
+	virtual ~Optimizer() = default;
+
+	/**
+	 * Get number of state values by parameter
+	 * @return number of state arrays
+	 */
+	virtual size_t getStatesCount() const = 0;
+
+	/**
+	 * Allocate the state (zero filled) of the parameters of a network
+	 * @param parametersCount number of parameters (offsets are lower)
+	 */
+	virtual void reserve(size_t parametersCount) {
+		this->parametersCount = parametersCount;
+		std::vector<T, AlignedAllocator<T>>(getStatesCount() * parametersCount, 0).swap(states);
+	}
+
+	/**
+	 * Start a learning step (called once before the updates of the step)
+	 */
+	virtual void step() {}
+
+	/**
+	 * Update parameters with the gradient scale * gradients (called by several threads at once
+	 * on different parameters: only the state of the updated parameters can be written)
+	 * @param offset offset of the first parameter (in the parameters of the network)
+	 * @param parameters parameters (count)
+	 * @param gradients gradients (count)
+	 * @param scale factor of the gradients
+	 * @param learningRate alpha value used in weight computation
+	 * @param count number of parameters
+	 */
+	virtual void update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) = 0;
+};
+
+#endif /* OPTIMIZER_OPTIMIZER_HPP_ */
@@ -0,0 +1,23 @@
+/*
+ * Sgd.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Sgd.hpp"
+#include "../../../Kernel/Kernel.hpp"
+
+template<typename T>
+size_t Sgd<T>::getStatesCount() const {
+	return 0;
+}
+
+template<typename T>
+void Sgd<T>::update(size_t, T* parameters, const T* gradients, T scale, T learningRate, size_t count) {
+	// w = w - alpha * g
+	Kernel::axpy<T>(count, -learningRate * scale, gradients, parameters);
+}
+
+template class Sgd<float>;
+template class Sgd<double>;
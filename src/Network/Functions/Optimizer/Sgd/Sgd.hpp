@@ -0,0 +1,23 @@
+/*
+ * Sgd.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef SGD_SGD_HPP_
+#define SGD_SGD_HPP_
+
+#include "../Optimizer.hpp"
+
+/**
+ * Stochastic gradient descent: w = w - alpha * g
+ */
+template<typename T>
+class Sgd : public Optimizer<T> {
+public:
+	size_t getStatesCount() const override;
+	void update(size_t offset, T* parameters, const T* gradients, T scale, T learningRate, size_t count) override;
+};
+
+#endif /* SGD_SGD_HPP_ */
@@ -0,0 +1,252 @@
+/*
+ * IncrementalEstimator.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+
+#include "IncrementalEstimator.hpp"
+#include "../Kernel/Kernel.hpp"
+
+#include "../Functions/Excitation/ExcitationKernel.hpp"
+
+template<typename T>
+IncrementalEstimator<T>::IncrementalEstimator(const Network<T>& network, double maxChangedRatio, unsigned int refreshInterval) : network(network) {
+	// Check if the network is ready
+	size_t layersCount = network.getLayersCount();
+	if (layersCount < 2 || network.getLayer(layersCount - 1).getType() != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("The network is not complete");
+	}
+
+	// Control input parameters
+	if (!(maxChangedRatio > 0 && maxChangedRatio <= 1)) {
+		throw std::invalid_argument("The max changed ratio should be in ]0, 1]");
+	}
+	if (refreshInterval == 0) {
+		throw std::invalid_argument("The refresh interval should be at least 1");
+	}
+	this->maxChangedRatio = maxChangedRatio;
+	this->refreshInterval = refreshInterval;
+
+	// Weights by column: the changes of an input value read contiguous weights
+	columnWeights.resize(layersCount);
+	columnOffsets.resize(layersCount);
+	rows.resize(layersCount);
+	inputValues.resize(layersCount);
+	outputValues.resize(layersCount);
+	outputValues.at(0).assign(network.getLayer(0).getNeuralsCount(), 0);
+	size_t maxNeuralsCount = 0;
+	for (size_t i = 1; i < layersCount; ++i) {
+		const Layer<T>& layer = network.getLayer(i);
+		size_t neuralsCount = layer.getNeuralsCount();
+		size_t inputsCount = layer.getInputsCount();
+		const T* weights = layer.getWeights();
+		if (layer.getAggregationType() == AggregationType::NO_AGG) {
+			// Always fully computed
+		} else if (layer.isSparse()) {
+			// Transpose the CSR links (rows stay sorted in each column)
+			const std::vector<unsigned int>& layerRowOffsets = layer.getRowOffsets();
+			const std::vector<unsigned int>& layerColumns = layer.getColumns();
+			std::vector<unsigned int>& offsets = columnOffsets.at(i);
+			offsets.assign(inputsCount + 1, 0);
+			for (unsigned int column : layerColumns) {
+				++offsets[column + 1];
+			}
+			for (size_t j = 0; j < inputsCount; ++j) {
+				offsets[j + 1] += offsets[j];
+			}
+			std::vector<unsigned int> next(offsets.begin(), offsets.end() - 1);
+			rows.at(i).resize(layerColumns.size());
+			columnWeights.at(i).resize(layerColumns.size());
+			for (size_t r = 0; r < neuralsCount; ++r) {
+				for (unsigned int l = layerRowOffsets[r]; l < layerRowOffsets[r + 1]; ++l) {
+					unsigned int position = next[layerColumns[l]]++;
+					rows.at(i)[position] = (unsigned int) r;
+					columnWeights.at(i)[position] = weights[l];
+				}
+			}
+		} else {
+			std::vector<T>& w = columnWeights.at(i);
+			w.resize(inputsCount * neuralsCount);
+			for (size_t r = 0; r < neuralsCount; ++r) {
+				for (size_t j = 0; j < inputsCount; ++j) {
+					w[j * neuralsCount + r] = weights[r * inputsCount + j];
+				}
+			}
+		}
+		inputValues.at(i).assign(neuralsCount, 0);
+		outputValues.at(i).assign(neuralsCount, 0);
+		maxNeuralsCount = std::max(maxNeuralsCount, neuralsCount);
+	}
+	values.resize(maxNeuralsCount);
+
+	isValid = false;
+	stepsCount = 0;
+	fullCount = 0;
+	incrementalCount = 0;
+}
+
+template<typename T>
+int IncrementalEstimator<T>::estimate(const std::vector<T>& inputValues) {
+	// Control input parameter: input values
+	std::vector<T>& inputs = outputValues.at(0);
+	if (inputValues.size() < inputs.size()) {
+		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
+	}
+
+	// Differences with the last input values
+	changedIndexes[0].clear();
+	changedValues[0].clear();
+	for (size_t j = 0; j < inputs.size(); ++j) {
+		if (inputValues[j] != inputs[j]) {
+			changedIndexes[0].push_back((unsigned int) j);
+			changedValues[0].push_back(inputValues[j] - inputs[j]);
+			inputs[j] = inputValues[j];
+		}
+	}
+	return compute();
+}
+
+template<typename T>
+int IncrementalEstimator<T>::estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues) {
+	// Copy the output values and return max class
+	int maxClass = estimate(inputValues);
+	outputValues.assign(this->outputValues.back().begin(), this->outputValues.back().end());
+	return maxClass;
+}
+
+template<typename T>
+int IncrementalEstimator<T>::update(const std::vector<unsigned int>& indexes, const std::vector<T>& newValues, std::vector<T>& outputValues) {
+	// Control input parameters: indexes and values
+	std::vector<T>& inputs = this->outputValues.at(0);
+	if (indexes.size() != newValues.size()) {
+		throw std::invalid_argument("There should be one value by index");
+	}
+	for (unsigned int j : indexes) {
+		if (j >= inputs.size()) {
+			throw std::invalid_argument("The index should be lower than the number of input neurals");
+		}
+	}
+
+	// Differences with the last input values (in order: an index can be repeated)
+	changedIndexes[0].clear();
+	changedValues[0].clear();
+	for (size_t k = 0; k < indexes.size(); ++k) {
+		unsigned int j = indexes[k];
+		if (newValues[k] != inputs[j]) {
+			changedIndexes[0].push_back(j);
+			changedValues[0].push_back(newValues[k] - inputs[j]);
+			inputs[j] = newValues[k];
+		}
+	}
+
+	// Copy the output values and return max class
+	int maxClass = compute();
+	outputValues.assign(this->outputValues.back().begin(), this->outputValues.back().end());
+	return maxClass;
+}
+
+template<typename T>
+int IncrementalEstimator<T>::compute() {
+	// Full estimation without last one, with too many changes or to bound the drift
+	size_t inputsCount = outputValues.at(0).size();
+	if (!isValid || stepsCount >= refreshInterval || changedIndexes[0].size() > maxChangedRatio * inputsCount) {
+		computeFull();
+	} else {
+		computeChanges();
+	}
+
+	// Get the highest output neural
+	const std::vector<T>& outputs = outputValues.back();
+	int maxClass = 0;
+	for (unsigned int i = 1; i < outputs.size(); ++i) {
+		if (outputs[i] > outputs[maxClass]) {
+			maxClass = i;
+		}
+	}
+	return maxClass;
+}
+
+template<typename T>
+void IncrementalEstimator<T>::computeFull() {
+	for (size_t i = 1; i < outputValues.size(); ++i) {
+		network.getLayer(i).forwardPropagation(outputValues.at(i - 1).data(), inputValues.at(i).data(), outputValues.at(i).data());
+	}
+	isValid = true;
+	stepsCount = 0;
+	++fullCount;
+}
+
+template<typename T>
+void IncrementalEstimator<T>::computeChanges() {
+	for (size_t i = 1; i < outputValues.size() && !changedIndexes[0].empty(); ++i) {
+		const Layer<T>& layer = network.getLayer(i);
+		size_t neuralsCount = layer.getNeuralsCount();
+		T* inputs = inputValues.at(i).data();
+
+		if (layer.getAggregationType() == AggregationType::NO_AGG || changedIndexes[0].size() > maxChangedRatio * layer.getInputsCount()) {
+			// Too many changes: full layer (its input values do not drift any more)
+			layer.forwardPropagation(outputValues.at(i - 1).data(), inputs, values.data());
+		} else {
+			// Add one column of the weights by changed input, then excite
+			const T* weights = columnWeights.at(i).data();
+			if (layer.isSparse()) {
+				const unsigned int* offsets = columnOffsets.at(i).data();
+				const unsigned int* columnRows = rows.at(i).data();
+				for (size_t k = 0; k < changedIndexes[0].size(); ++k) {
+					unsigned int j = changedIndexes[0][k];
+					T difference = changedValues[0][k];
+					for (unsigned int l = offsets[j]; l < offsets[j + 1]; ++l) {
+						inputs[columnRows[l]] += weights[l] * difference;
+					}
+				}
+			} else {
+				for (size_t k = 0; k < changedIndexes[0].size(); ++k) {
+					Kernel::axpy<T>(neuralsCount, changedValues[0][k], weights + changedIndexes[0][k] * neuralsCount, inputs);
+				}
+			}
+			ExcitationKernel::compute(layer.getExcitationType(), inputs, values.data(), neuralsCount);
+		}
+		updateOutputs(i);
+	}
+	++stepsCount;
+	++incrementalCount;
+}
+
+template<typename T>
+void IncrementalEstimator<T>::updateOutputs(size_t layer) {
+	// Changed outputs are the changed inputs of the next layer
+	std::vector<T>& outputs = outputValues.at(layer);
+	changedIndexes[1].clear();
+	changedValues[1].clear();
+	for (size_t r = 0; r < outputs.size(); ++r) {
+		if (values[r] != outputs[r]) {
+			changedIndexes[1].push_back((unsigned int) r);
+			changedValues[1].push_back(values[r] - outputs[r]);
+			outputs[r] = values[r];
+		}
+	}
+	changedIndexes[0].swap(changedIndexes[1]);
+	changedValues[0].swap(changedValues[1]);
+}
+
+template<typename T>
+void IncrementalEstimator<T>::reset() {
+	isValid = false;
+}
+
+template<typename T>
+uint64_t IncrementalEstimator<T>::getFullCount() const {
+	return fullCount;
+}
+
+template<typename T>
+uint64_t IncrementalEstimator<T>::getIncrementalCount() const {
+	return incrementalCount;
+}
+
+template class IncrementalEstimator<float>;
+template class IncrementalEstimator<double>;
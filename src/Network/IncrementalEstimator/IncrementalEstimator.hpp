@@ -0,0 +1,182 @@
+/*
+ * IncrementalEstimator.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef INCREMENTALESTIMATOR_INCREMENTALESTIMATOR_HPP_
+#define INCREMENTALESTIMATOR_INCREMENTALESTIMATOR_HPP_
+
+#include <vector>
+#include <cstdint>
+
+#include "../Network.hpp"
+
+/**
+ * Estimation of a stream of samples which differ by a few input values
+ *
+ * The input and output values of every layer of the last estimation are kept: the weighted
+ * differences of the changed values only are added to the input values of the next layer
+ * (one column of the weights by changed value), then the layer is excited and its changed
+ * outputs are pushed to the next one. A layer is fully computed when too many of its inputs
+ * changed, and the whole network when too many input values changed or after a number of
+ * incremental estimations (the sums of differences drift from the full sums)
+ *
+ * The weights are copied by column at the construction: the network should not be changed
+ * (learning, pruning, loading) while the estimator is used
+ */
+template<typename T>
+class IncrementalEstimator {
+protected:
+	/**
+	 * Estimated network
+	 */
+	const Network<T>& network;
+
+	/**
+	 * Max ratio of changed inputs of a layer to add the differences (fully computed above)
+	 */
+	double maxChangedRatio;
+
+	/**
+	 * Number of incremental estimations between two full estimations
+	 */
+	unsigned int refreshInterval;
+
+	/**
+	 * Weights of each layer by column (inputsCount x neuralsCount for a dense layer, the links
+	 * by column for a sparse layer)
+	 */
+	std::vector<std::vector<T>> columnWeights;
+
+	/**
+	 * First link of each column of each sparse layer (inputsCount + 1)
+	 */
+	std::vector<std::vector<unsigned int>> columnOffsets;
+
+	/**
+	 * Neural of each link of each sparse layer, by column
+	 */
+	std::vector<std::vector<unsigned int>> rows;
+
+	/**
+	 * Input values of each layer of the last estimation
+	 */
+	std::vector<std::vector<T>> inputValues;
+
+	/**
+	 * Output values of each layer of the last estimation (input values for the input layer)
+	 */
+	std::vector<std::vector<T>> outputValues;
+
+	/**
+	 * New output values of the current layer
+	 */
+	std::vector<T> values;
+
+	/**
+	 * Indexes and differences of the changed outputs of the previous and the current layer
+	 */
+	std::vector<unsigned int> changedIndexes[2];
+	std::vector<T> changedValues[2];
+
+	/**
+	 * Is there a last estimation
+	 */
+	bool isValid;
+
+	/**
+	 * Number of incremental estimations since the last full one
+	 */
+	unsigned int stepsCount;
+
+	/**
+	 * Number of full and incremental estimations
+	 */
+	uint64_t fullCount;
+	uint64_t incrementalCount;
+
+protected:
+	/**
+	 * Compute the estimation of the changed input values (changedIndexes[0] and changedValues[0]),
+	 * incremental or full
+	 * @return the max class
+	 */
+	int compute();
+
+	/**
+	 * Compute all the layers from the input values
+	 */
+	void computeFull();
+
+	/**
+	 * Propagate the changed input values (changedIndexes[0] and changedValues[0])
+	 */
+	void computeChanges();
+
+	/**
+	 * Keep the new output values of a layer and list the changed ones (changedIndexes[1] and
+	 * changedValues[1])
+	 * @param layer layer index
+	 */
+	void updateOutputs(size_t layer);
+
+public:
+	/**
+	 * Constructor
+	 * @param network estimated network
+	 * @param maxChangedRatio max ratio of changed inputs of a layer to add the differences, in ]0, 1]
+	 * @param refreshInterval number of incremental estimations between two full estimations (at least 1)
+	 * @throw logic_error if the network is not complete
+	 * @throw invalid_argument if the ratio or the interval are not correct
+	 */
+	IncrementalEstimator(const Network<T>& network, double maxChangedRatio = 0.1, unsigned int refreshInterval = 1000);
+
+	/**
+	 * Compute estimation from the differences with the input values of the last estimation
+	 * @param inputValues input values
+	 * @return the max class
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int estimate(const std::vector<T>& inputValues);
+
+	/**
+	 * Compute estimation from the differences with the input values of the last estimation
+	 * @param inputValues input values
+	 * @param outputValues output values of the last layer
+	 * @return the max class
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues);
+
+	/**
+	 * Compute estimation with some input values changed (the other ones are the input values
+	 * of the last estimation, zero before the first one)
+	 * @param indexes indexes of the changed input values
+	 * @param newValues new input values (one by index)
+	 * @param outputValues output values of the last layer
+	 * @return the max class
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int update(const std::vector<unsigned int>& indexes, const std::vector<T>& newValues, std::vector<T>& outputValues);
+
+	/**
+	 * Forget the last estimation (the next one is full)
+	 */
+	void reset();
+
+	/**
+	 * Get number of full estimations
+	 * @return number of estimations
+	 */
+	uint64_t getFullCount() const;
+
+	/**
+	 * Get number of incremental estimations
+	 * @return number of estimations
+	 */
+	uint64_t getIncrementalCount() const;
+};
+
+#endif /* INCREMENTALESTIMATOR_INCREMENTALESTIMATOR_HPP_ */
@@ -0,0 +1,619 @@
+/*
+ * Kernel.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <vector>
+#include <algorithm>
+
+#include "Kernel.hpp"
+#include "../Simd/Simd.hpp"
+
+namespace Kernel {
+
+	/**
+	 * Register tile and cache blocks of the matrix-matrix product
+	 *  - MR x NR: tile of C kept in registers by the micro-kernel
+	 *  - KC: depth of the packed panels (a panel of A and B stays in L1)
+	 *  - MC: rows of the packed block of A (stays in L2)
+	 *  - NC: columns of the packed block of B (stays in L3)
+	 */
+	template<typename T>
+	struct Blocking {
+		static const size_t MR = 6;
+		static const size_t NR = 2 * Simd::Vec<T>::width;
+		static const size_t KC = 256;
+		static const size_t MC = MR * 20;
+		static const size_t NC = 1024;
+	};
+
+	/**
+	 * Get the value (i, j) of op(M)
+	 */
+	template<typename T>
+	inline T valueAt(Transpose trans, const T* m, size_t ld, size_t i, size_t j) {
+		return trans == Transpose::NO_TRANS ? m[i * ld + j] : m[j * ld + i];
+	}
+
+	/**
+	 * Pack a block of op(A) (mc x kc) in panels of MR rows, each panel is stored column by column
+	 */
+	template<typename T>
+	void packA(Transpose trans, const T* a, size_t lda, size_t i0, size_t p0, size_t mc, size_t kc, T* packed) {
+		const size_t MR = Blocking<T>::MR;
+		for (size_t ir = 0; ir < mc; ir += MR) {
+			size_t mr = std::min(MR, mc - ir);
+			for (size_t p = 0; p < kc; ++p) {
+				for (size_t i = 0; i < mr; ++i) {
+					packed[p * MR + i] = valueAt(trans, a, lda, i0 + ir + i, p0 + p);
+				}
+				for (size_t i = mr; i < MR; ++i) {
+					packed[p * MR + i] = T(0);
+				}
+			}
+			packed += MR * kc;
+		}
+	}
+
+	/**
+	 * Pack a block of op(B) (kc x nc) in panels of NR columns, each panel is stored row by row
+	 */
+	template<typename T>
+	void packB(Transpose trans, const T* b, size_t ldb, size_t p0, size_t j0, size_t kc, size_t nc, T* packed) {
+		const size_t NR = Blocking<T>::NR;
+		for (size_t jr = 0; jr < nc; jr += NR) {
+			size_t nr = std::min(NR, nc - jr);
+			for (size_t p = 0; p < kc; ++p) {
+				if (trans == Transpose::NO_TRANS && nr == NR) {
+					std::copy(b + (p0 + p) * ldb + j0 + jr, b + (p0 + p) * ldb + j0 + jr + NR, packed + p * NR);
+					continue;
+				}
+				for (size_t j = 0; j < nr; ++j) {
+					packed[p * NR + j] = valueAt(trans, b, ldb, p0 + p, j0 + jr + j);
+				}
+				for (size_t j = nr; j < NR; ++j) {
+					packed[p * NR + j] = T(0);
+				}
+			}
+			packed += NR * kc;
+		}
+	}
+
+	/**
+	 * Micro-kernel: ab (MR x NR) = panel of A * panel of B
+	 * The 6 x 2 accumulators are unrolled by hand so they stay in registers
+	 */
+	template<typename T>
+	inline void microKernel(size_t kc, const T* pa, const T* pb, T* ab) {
+		typedef Simd::Vec<T> V;
+		typedef typename V::type R;
+		const size_t W = V::width;
+		const size_t MR = Blocking<T>::MR;
+		const size_t NR = Blocking<T>::NR;
+
+		R c00 = V::zero(), c01 = V::zero();
+		R c10 = V::zero(), c11 = V::zero();
+		R c20 = V::zero(), c21 = V::zero();
+		R c30 = V::zero(), c31 = V::zero();
+		R c40 = V::zero(), c41 = V::zero();
+		R c50 = V::zero(), c51 = V::zero();
+
+		for (size_t p = 0; p < kc; ++p) {
+			R b0 = V::load(pb);
+			R b1 = V::load(pb + W);
+			R a;
+			a = V::set1(pa[0]);
+			c00 = V::fmadd(a, b0, c00);
+			c01 = V::fmadd(a, b1, c01);
+			a = V::set1(pa[1]);
+			c10 = V::fmadd(a, b0, c10);
+			c11 = V::fmadd(a, b1, c11);
+			a = V::set1(pa[2]);
+			c20 = V::fmadd(a, b0, c20);
+			c21 = V::fmadd(a, b1, c21);
+			a = V::set1(pa[3]);
+			c30 = V::fmadd(a, b0, c30);
+			c31 = V::fmadd(a, b1, c31);
+			a = V::set1(pa[4]);
+			c40 = V::fmadd(a, b0, c40);
+			c41 = V::fmadd(a, b1, c41);
+			a = V::set1(pa[5]);
+			c50 = V::fmadd(a, b0, c50);
+			c51 = V::fmadd(a, b1, c51);
+			pa += MR;
+			pb += NR;
+		}
+
+		V::store(ab, c00);
+		V::store(ab + W, c01);
+		V::store(ab + NR, c10);
+		V::store(ab + NR + W, c11);
+		V::store(ab + 2 * NR, c20);
+		V::store(ab + 2 * NR + W, c21);
+		V::store(ab + 3 * NR, c30);
+		V::store(ab + 3 * NR + W, c31);
+		V::store(ab + 4 * NR, c40);
+		V::store(ab + 4 * NR + W, c41);
+		V::store(ab + 5 * NR, c50);
+		V::store(ab + 5 * NR + W, c51);
+	}
+
+	/**
+	 * Scale a matrix C = beta * C (C is not read if beta = 0)
+	 */
+	template<typename T>
+	void scale(size_t m, size_t n, T beta, T* c, size_t ldc) {
+		if (beta == T(1)) {
+			return;
+		}
+		for (size_t i = 0; i < m; ++i) {
+			T* row = c + i * ldc;
+			if (beta == T(0)) {
+				std::fill(row, row + n, T(0));
+			} else {
+				for (size_t j = 0; j < n; ++j) {
+					row[j] *= beta;
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void gemm(Transpose transA, Transpose transB, size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc) {
+		typedef Blocking<T> B;
+
+		scale(m, n, beta, c, ldc);
+		if (m == 0 || n == 0 || k == 0 || alpha == T(0)) {
+			return;
+		}
+
+		// Packing buffers (one set by thread)
+		static thread_local std::vector<T> packedA;
+		static thread_local std::vector<T> packedB;
+		packedA.resize(B::MC * B::KC);
+		packedB.resize(B::KC * (B::NC + B::NR));
+		T ab[B::MR * B::NR];
+
+		for (size_t jc = 0; jc < n; jc += B::NC) {
+			size_t nc = std::min(B::NC, n - jc);
+			for (size_t pc = 0; pc < k; pc += B::KC) {
+				size_t kc = std::min(B::KC, k - pc);
+				packB(transB, b, ldb, pc, jc, kc, nc, packedB.data());
+
+				for (size_t ic = 0; ic < m; ic += B::MC) {
+					size_t mc = std::min(B::MC, m - ic);
+					packA(transA, a, lda, ic, pc, mc, kc, packedA.data());
+
+					for (size_t jr = 0; jr < nc; jr += B::NR) {
+						size_t nr = std::min(B::NR, nc - jr);
+						for (size_t ir = 0; ir < mc; ir += B::MR) {
+							size_t mr = std::min(B::MR, mc - ir);
+							microKernel(kc, packedA.data() + ir * kc, packedB.data() + jr * kc, ab);
+
+							// C += alpha * AB (only the valid part of the tile)
+							for (size_t i = 0; i < mr; ++i) {
+								T* row = c + (ic + ir + i) * ldc + jc + jr;
+								for (size_t j = 0; j < nr; ++j) {
+									row[j] += alpha * ab[i * B::NR + j];
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	template<typename T>
+	void gemv(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		// Four rows at once: x is loaded once for four dot products
+		size_t i = 0;
+		for (; i + 4 <= m; i += 4) {
+			const T* a0 = a + i * lda;
+			const T* a1 = a0 + lda;
+			const T* a2 = a1 + lda;
+			const T* a3 = a2 + lda;
+			typename V::type s0 = V::zero(), s1 = V::zero(), s2 = V::zero(), s3 = V::zero();
+			size_t j = 0;
+			for (; j + W <= n; j += W) {
+				typename V::type xj = V::load(x + j);
+				s0 = V::fmadd(V::load(a0 + j), xj, s0);
+				s1 = V::fmadd(V::load(a1 + j), xj, s1);
+				s2 = V::fmadd(V::load(a2 + j), xj, s2);
+				s3 = V::fmadd(V::load(a3 + j), xj, s3);
+			}
+			T r0 = V::sum(s0), r1 = V::sum(s1), r2 = V::sum(s2), r3 = V::sum(s3);
+			for (; j < n; ++j) {
+				r0 += a0[j] * x[j];
+				r1 += a1[j] * x[j];
+				r2 += a2[j] * x[j];
+				r3 += a3[j] * x[j];
+			}
+			y[i] = alpha * r0 + (beta == T(0) ? T(0) : beta * y[i]);
+			y[i + 1] = alpha * r1 + (beta == T(0) ? T(0) : beta * y[i + 1]);
+			y[i + 2] = alpha * r2 + (beta == T(0) ? T(0) : beta * y[i + 2]);
+			y[i + 3] = alpha * r3 + (beta == T(0) ? T(0) : beta * y[i + 3]);
+		}
+
+		// Remaining rows
+		for (; i < m; ++i) {
+			const T* row = a + i * lda;
+			typename V::type s = V::zero();
+			size_t j = 0;
+			for (; j + W <= n; j += W) {
+				s = V::fmadd(V::load(row + j), V::load(x + j), s);
+			}
+			T r = V::sum(s);
+			for (; j < n; ++j) {
+				r += row[j] * x[j];
+			}
+			y[i] = alpha * r + (beta == T(0) ? T(0) : beta * y[i]);
+		}
+	}
+
+	template<typename T>
+	void gemvT(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		scale(1, n, beta, y, n);
+
+		// Four rows at once: y is loaded and stored once for four rows
+		size_t i = 0;
+		for (; i + 4 <= m; i += 4) {
+			const T* a0 = a + i * lda;
+			const T* a1 = a0 + lda;
+			const T* a2 = a1 + lda;
+			const T* a3 = a2 + lda;
+			T x0 = alpha * x[i], x1 = alpha * x[i + 1], x2 = alpha * x[i + 2], x3 = alpha * x[i + 3];
+			typename V::type v0 = V::set1(x0), v1 = V::set1(x1), v2 = V::set1(x2), v3 = V::set1(x3);
+			size_t j = 0;
+			for (; j + W <= n; j += W) {
+				typename V::type s = V::load(y + j);
+				s = V::fmadd(V::load(a0 + j), v0, s);
+				s = V::fmadd(V::load(a1 + j), v1, s);
+				s = V::fmadd(V::load(a2 + j), v2, s);
+				s = V::fmadd(V::load(a3 + j), v3, s);
+				V::store(y + j, s);
+			}
+			for (; j < n; ++j) {
+				y[j] += a0[j] * x0 + a1[j] * x1 + a2[j] * x2 + a3[j] * x3;
+			}
+		}
+
+		// Remaining rows
+		for (; i < m; ++i) {
+			axpy(n, alpha * x[i], a + i * lda, y);
+		}
+	}
+
+	template<typename T>
+	void ger(size_t m, size_t n, T alpha, const T* x, const T* y, T* a, size_t lda) {
+		for (size_t i = 0; i < m; ++i) {
+			axpy(n, alpha * x[i], y, a + i * lda);
+		}
+	}
+
+	template<typename T>
+	void axpy(size_t n, T alpha, const T* x, T* y) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		typename V::type va = V::set1(alpha);
+		size_t j = 0;
+		for (; j + W <= n; j += W) {
+			V::store(y + j, V::fmadd(va, V::load(x + j), V::load(y + j)));
+		}
+		for (; j < n; ++j) {
+			y[j] += alpha * x[j];
+		}
+	}
+
+	template<typename T>
+	void mul(size_t n, const T* x, T* y) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		size_t j = 0;
+		for (; j + W <= n; j += W) {
+			V::store(y + j, V::mul(V::load(x + j), V::load(y + j)));
+		}
+		for (; j < n; ++j) {
+			y[j] *= x[j];
+		}
+	}
+
+	template<typename T>
+	void spmv(size_t m, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, T beta, T* y) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		for (size_t i = 0; i < m; ++i) {
+			// W links at once (the values of x are gathered), two independent sums
+			typename V::type s0 = V::zero();
+			typename V::type s1 = V::zero();
+			size_t p = rowOffsets[i];
+			const size_t last = rowOffsets[i + 1];
+			for (; p + 2 * W <= last; p += 2 * W) {
+				s0 = V::fmadd(V::load(values + p), V::gather(x, columns + p), s0);
+				s1 = V::fmadd(V::load(values + p + W), V::gather(x, columns + p + W), s1);
+			}
+			for (; p + W <= last; p += W) {
+				s0 = V::fmadd(V::load(values + p), V::gather(x, columns + p), s0);
+			}
+			T s = V::sum(V::add(s0, s1));
+			for (; p < last; ++p) {
+				s += values[p] * x[columns[p]];
+			}
+			y[i] = alpha * s + (beta == T(0) ? T(0) : beta * y[i]);
+		}
+	}
+
+	template<typename T>
+	void spmvT(size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, T beta, T* y) {
+		scale(1, n, beta, y, n);
+
+		// Scatter each row (skipped if its value is zero)
+		for (size_t i = 0; i < m; ++i) {
+			T xi = alpha * x[i];
+			if (xi == T(0)) {
+				continue;
+			}
+			for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+				y[columns[p]] += xi * values[p];
+			}
+		}
+	}
+
+	template<typename T>
+	void spmm(size_t rowsCount, size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, T beta, T* y, size_t ldy) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		// Blocks of W rows of X packed by column (one vector by column) and their products
+		static thread_local std::vector<T> packedX;
+		static thread_local std::vector<T> packedY;
+		packedX.resize(n * W);
+		packedY.resize(m * W);
+
+		size_t r = 0;
+		for (; r + W <= rowsCount; r += W) {
+			for (size_t s = 0; s < W; ++s) {
+				const T* xs = x + (r + s) * ldx;
+				for (size_t c = 0; c < n; ++c) {
+					packedX[c * W + s] = xs[c];
+				}
+			}
+			for (size_t i = 0; i < m; ++i) {
+				// Four independent sums (the latency of the products is hidden)
+				typename V::type s0 = V::zero();
+				typename V::type s1 = V::zero();
+				typename V::type s2 = V::zero();
+				typename V::type s3 = V::zero();
+				size_t p = rowOffsets[i];
+				const size_t last = rowOffsets[i + 1];
+				for (; p + 4 <= last; p += 4) {
+					s0 = V::fmadd(V::set1(values[p]), V::load(packedX.data() + (size_t) columns[p] * W), s0);
+					s1 = V::fmadd(V::set1(values[p + 1]), V::load(packedX.data() + (size_t) columns[p + 1] * W), s1);
+					s2 = V::fmadd(V::set1(values[p + 2]), V::load(packedX.data() + (size_t) columns[p + 2] * W), s2);
+					s3 = V::fmadd(V::set1(values[p + 3]), V::load(packedX.data() + (size_t) columns[p + 3] * W), s3);
+				}
+				for (; p < last; ++p) {
+					s0 = V::fmadd(V::set1(values[p]), V::load(packedX.data() + (size_t) columns[p] * W), s0);
+				}
+				V::store(packedY.data() + i * W, V::add(V::add(s0, s1), V::add(s2, s3)));
+			}
+			for (size_t s = 0; s < W; ++s) {
+				T* ys = y + (r + s) * ldy;
+				for (size_t i = 0; i < m; ++i) {
+					ys[i] = alpha * packedY[i * W + s] + (beta == T(0) ? T(0) : beta * ys[i]);
+				}
+			}
+		}
+		for (; r < rowsCount; ++r) {
+			spmv(m, alpha, values, rowOffsets, columns, x + r * ldx, beta, y + r * ldy);
+		}
+	}
+
+	template<typename T>
+	void spmmT(size_t rowsCount, size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, T beta, T* y, size_t ldy) {
+		for (size_t r = 0; r < rowsCount; ++r) {
+			spmvT(m, n, alpha, values, rowOffsets, columns, x + r * ldx, beta, y + r * ldy);
+		}
+	}
+
+	template<typename T>
+	void sddmm(size_t rowsCount, size_t m, size_t n, T alpha, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, const T* y, size_t ldy, T beta, T* values) {
+		typedef Simd::Vec<T> V;
+		const size_t W = V::width;
+
+		scale<T>(1, rowOffsets[m] - rowOffsets[0], beta, values + rowOffsets[0], rowOffsets[m] - rowOffsets[0]);
+
+		// Less rows than a vector: the rows are scattered one by one on the links
+		if (rowsCount < W) {
+			for (size_t r = 0; r < rowsCount; ++r) {
+				const T* xr = x + r * ldx;
+				const T* yr = y + r * ldy;
+				for (size_t i = 0; i < m; ++i) {
+					T xi = alpha * xr[i];
+					if (xi == T(0)) {
+						continue;
+					}
+					for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+						values[p] += xi * yr[columns[p]];
+					}
+				}
+			}
+			return;
+		}
+
+		// Blocks of rows packed by column (a column of X and of Y are contiguous, zero padded)
+		const size_t BLOCK = 64;
+		static thread_local std::vector<T> packedX;
+		static thread_local std::vector<T> packedY;
+		packedX.resize(m * BLOCK);
+		packedY.resize(n * BLOCK);
+
+		for (size_t r0 = 0; r0 < rowsCount; r0 += BLOCK) {
+			size_t count = std::min(BLOCK, rowsCount - r0);
+			size_t paddedCount = (count + W - 1) / W * W;
+			for (size_t s = 0; s < paddedCount; ++s) {
+				const T* xs = x + (r0 + s) * ldx;
+				const T* ys = y + (r0 + s) * ldy;
+				for (size_t i = 0; i < m; ++i) {
+					packedX[i * BLOCK + s] = s < count ? xs[i] : T(0);
+				}
+				for (size_t c = 0; c < n; ++c) {
+					packedY[c * BLOCK + s] = s < count ? ys[c] : T(0);
+				}
+			}
+
+			// values[p] += alpha * X(:, i)' * Y(:, column of p)
+			for (size_t i = 0; i < m; ++i) {
+				const T* xi = packedX.data() + i * BLOCK;
+				for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+					const T* yc = packedY.data() + (size_t) columns[p] * BLOCK;
+					typename V::type s0 = V::zero();
+					typename V::type s1 = V::zero();
+					size_t s = 0;
+					for (; s + 2 * W <= paddedCount; s += 2 * W) {
+						s0 = V::fmadd(V::load(xi + s), V::load(yc + s), s0);
+						s1 = V::fmadd(V::load(xi + s + W), V::load(yc + s + W), s1);
+					}
+					if (s < paddedCount) {
+						s0 = V::fmadd(V::load(xi + s), V::load(yc + s), s0);
+					}
+					values[p] += alpha * V::sum(V::add(s0, s1));
+				}
+			}
+		}
+	}
+
+	void gemvInt8(size_t m, size_t n, const int8_t* a, size_t lda, const int8_t* x, const int32_t* rowSums, int32_t* y) {
+#if defined(ANN_SIMD_AVX512) && defined(__AVX512VNNI__)
+		// vpdpbusd multiplies unsigned by signed bytes: x + 128 is unsigned
+		// and A * (x + 128) - 128 * sum(A) = A * x
+		const __m512i offset = _mm512_set1_epi8((char) 0x80);
+		size_t i = 0;
+		for (; i + 4 <= m; i += 4) {
+			const int8_t* a0 = a + i * lda;
+			__m512i s0 = _mm512_setzero_si512(), s1 = _mm512_setzero_si512(), s2 = _mm512_setzero_si512(), s3 = _mm512_setzero_si512();
+			for (size_t j = 0; j < n; j += 64) {
+				__m512i xu = _mm512_xor_si512(_mm512_loadu_si512(x + j), offset);
+				s0 = _mm512_dpbusd_epi32(s0, xu, _mm512_loadu_si512(a0 + j));
+				s1 = _mm512_dpbusd_epi32(s1, xu, _mm512_loadu_si512(a0 + lda + j));
+				s2 = _mm512_dpbusd_epi32(s2, xu, _mm512_loadu_si512(a0 + 2 * lda + j));
+				s3 = _mm512_dpbusd_epi32(s3, xu, _mm512_loadu_si512(a0 + 3 * lda + j));
+			}
+			y[i] = _mm512_reduce_add_epi32(s0) - 128 * rowSums[i];
+			y[i + 1] = _mm512_reduce_add_epi32(s1) - 128 * rowSums[i + 1];
+			y[i + 2] = _mm512_reduce_add_epi32(s2) - 128 * rowSums[i + 2];
+			y[i + 3] = _mm512_reduce_add_epi32(s3) - 128 * rowSums[i + 3];
+		}
+		for (; i < m; ++i) {
+			__m512i s0 = _mm512_setzero_si512();
+			for (size_t j = 0; j < n; j += 64) {
+				__m512i xu = _mm512_xor_si512(_mm512_loadu_si512(x + j), offset);
+				s0 = _mm512_dpbusd_epi32(s0, xu, _mm512_loadu_si512(a + i * lda + j));
+			}
+			y[i] = _mm512_reduce_add_epi32(s0) - 128 * rowSums[i];
+		}
+#elif defined(ANN_SIMD_AVX2)
+		// vpmaddubsw multiplies unsigned by signed bytes: |x| * (A with the sign of x)
+		// (no saturation of the pairs with values in [-127, 127])
+		(void) rowSums;
+		const __m256i ones = _mm256_set1_epi16(1);
+		size_t i = 0;
+		for (; i + 4 <= m; i += 4) {
+			const int8_t* a0 = a + i * lda;
+			__m256i s0 = _mm256_setzero_si256(), s1 = _mm256_setzero_si256(), s2 = _mm256_setzero_si256(), s3 = _mm256_setzero_si256();
+			for (size_t j = 0; j < n; j += 32) {
+				__m256i xj = _mm256_loadu_si256((const __m256i*) (x + j));
+				__m256i ax = _mm256_abs_epi8(xj);
+				s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(_mm256_maddubs_epi16(ax, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*) (a0 + j)), xj)), ones));
+				s1 = _mm256_add_epi32(s1, _mm256_madd_epi16(_mm256_maddubs_epi16(ax, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*) (a0 + lda + j)), xj)), ones));
+				s2 = _mm256_add_epi32(s2, _mm256_madd_epi16(_mm256_maddubs_epi16(ax, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*) (a0 + 2 * lda + j)), xj)), ones));
+				s3 = _mm256_add_epi32(s3, _mm256_madd_epi16(_mm256_maddubs_epi16(ax, _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*) (a0 + 3 * lda + j)), xj)), ones));
+			}
+
+			// Horizontal sums of the four rows at once
+			__m256i s01 = _mm256_hadd_epi32(s0, s1);
+			__m256i s23 = _mm256_hadd_epi32(s2, s3);
+			__m256i s0123 = _mm256_hadd_epi32(s01, s23);
+			__m128i h = _mm_add_epi32(_mm256_castsi256_si128(s0123), _mm256_extracti128_si256(s0123, 1));
+			_mm_storeu_si128((__m128i*) (y + i), h);
+		}
+		for (; i < m; ++i) {
+			const int8_t* ai = a + i * lda;
+			__m256i s0 = _mm256_setzero_si256();
+			for (size_t j = 0; j < n; j += 32) {
+				__m256i xj = _mm256_loadu_si256((const __m256i*) (x + j));
+				s0 = _mm256_add_epi32(s0, _mm256_madd_epi16(_mm256_maddubs_epi16(_mm256_abs_epi8(xj), _mm256_sign_epi8(_mm256_loadu_si256((const __m256i*) (ai + j)), xj)), ones));
+			}
+			__m128i h = _mm_add_epi32(_mm256_castsi256_si128(s0), _mm256_extracti128_si256(s0, 1));
+			h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(1, 0, 3, 2)));
+			h = _mm_add_epi32(h, _mm_shuffle_epi32(h, _MM_SHUFFLE(2, 3, 0, 1)));
+			y[i] = _mm_cvtsi128_si32(h);
+		}
+#else
+		(void) rowSums;
+		for (size_t i = 0; i < m; ++i) {
+			const int8_t* ai = a + i * lda;
+			int32_t s = 0;
+			for (size_t j = 0; j < n; ++j) {
+				s += (int32_t) ai[j] * x[j];
+			}
+			y[i] = s;
+		}
+#endif
+	}
+
+	void spmvInt8(size_t m, const int8_t* values, const unsigned int* rowOffsets, const unsigned int* columns, const int8_t* x, int32_t* y) {
+		for (size_t i = 0; i < m; ++i) {
+			// Four links at once, independent sums (the int8 values of x are not gathered)
+			int32_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+			size_t p = rowOffsets[i];
+			const size_t last = rowOffsets[i + 1];
+			for (; p + 4 <= last; p += 4) {
+				s0 += (int32_t) values[p] * x[columns[p]];
+				s1 += (int32_t) values[p + 1] * x[columns[p + 1]];
+				s2 += (int32_t) values[p + 2] * x[columns[p + 2]];
+				s3 += (int32_t) values[p + 3] * x[columns[p + 3]];
+			}
+			for (; p < last; ++p) {
+				s0 += (int32_t) values[p] * x[columns[p]];
+			}
+			y[i] = s0 + s1 + s2 + s3;
+		}
+	}
+
+	// Instantiations
+	template void gemm<float>(Transpose, Transpose, size_t, size_t, size_t, float, const float*, size_t, const float*, size_t, float, float*, size_t);
+	template void gemm<double>(Transpose, Transpose, size_t, size_t, size_t, double, const double*, size_t, const double*, size_t, double, double*, size_t);
+	template void gemv<float>(size_t, size_t, float, const float*, size_t, const float*, float, float*);
+	template void gemv<double>(size_t, size_t, double, const double*, size_t, const double*, double, double*);
+	template void gemvT<float>(size_t, size_t, float, const float*, size_t, const float*, float, float*);
+	template void gemvT<double>(size_t, size_t, double, const double*, size_t, const double*, double, double*);
+	template void ger<float>(size_t, size_t, float, const float*, const float*, float*, size_t);
+	template void ger<double>(size_t, size_t, double, const double*, const double*, double*, size_t);
+	template void axpy<float>(size_t, float, const float*, float*);
+	template void axpy<double>(size_t, double, const double*, double*);
+	template void mul<float>(size_t, const float*, float*);
+	template void mul<double>(size_t, const double*, double*);
+	template void spmv<float>(size_t, float, const float*, const unsigned int*, const unsigned int*, const float*, float, float*);
+	template void spmv<double>(size_t, double, const double*, const unsigned int*, const unsigned int*, const double*, double, double*);
+	template void spmvT<float>(size_t, size_t, float, const float*, const unsigned int*, const unsigned int*, const float*, float, float*);
+	template void spmvT<double>(size_t, size_t, double, const double*, const unsigned int*, const unsigned int*, const double*, double, double*);
+	template void spmm<float>(size_t, size_t, size_t, float, const float*, const unsigned int*, const unsigned int*, const float*, size_t, float, float*, size_t);
+	template void spmm<double>(size_t, size_t, size_t, double, const double*, const unsigned int*, const unsigned int*, const double*, size_t, double, double*, size_t);
+	template void spmmT<float>(size_t, size_t, size_t, float, const float*, const unsigned int*, const unsigned int*, const float*, size_t, float, float*, size_t);
+	template void spmmT<double>(size_t, size_t, size_t, double, const double*, const unsigned int*, const unsigned int*, const double*, size_t, double, double*, size_t);
+	template void sddmm<float>(size_t, size_t, size_t, float, const unsigned int*, const unsigned int*, const float*, size_t, const float*, size_t, float, float*);
+	template void sddmm<double>(size_t, size_t, size_t, double, const unsigned int*, const unsigned int*, const double*, size_t, const double*, size_t, double, double*);
+
+}
@@ -0,0 +1,228 @@
+/*
+ * Kernel.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef KERNEL_KERNEL_HPP_
+#define KERNEL_KERNEL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Dense linear algebra kernels used by the layers (row-major matrices, no external BLAS) and
+ * sparse kernels of the matrices stored in compressed sparse rows (CSR: the links of a row
+ * are contiguous, rowOffsets[i] .. rowOffsets[i + 1] - 1 are the values and columns of row i)
+ *
+ * Instantiated for float and double
+ */
+namespace Kernel {
+
+	/**
+	 * Transposition of an operand
+	 */
+	enum class Transpose {
+		NO_TRANS, TRANS
+	};
+
+	/**
+	 * Matrix-matrix product C = alpha * op(A) * op(B) + beta * C
+	 * Packed and cache-blocked, computed by register-tiled micro-kernels
+	 * @param transA transposition of A
+	 * @param transB transposition of B
+	 * @param m number of rows of op(A) and C
+	 * @param n number of columns of op(B) and C
+	 * @param k number of columns of op(A) and rows of op(B)
+	 * @param alpha scale of the product
+	 * @param a matrix A
+	 * @param lda leading dimension of A (row stride)
+	 * @param b matrix B
+	 * @param ldb leading dimension of B (row stride)
+	 * @param beta scale of C (C is not read if beta = 0)
+	 * @param c matrix C
+	 * @param ldc leading dimension of C (row stride)
+	 */
+	template<typename T>
+	void gemm(Transpose transA, Transpose transB, size_t m, size_t n, size_t k, T alpha, const T* a, size_t lda, const T* b, size_t ldb, T beta, T* c, size_t ldc);
+
+	/**
+	 * Matrix-vector product y = alpha * A * x + beta * y
+	 * @param m number of rows of A
+	 * @param n number of columns of A
+	 * @param alpha scale of the product
+	 * @param a matrix A (m x n)
+	 * @param lda leading dimension of A (row stride)
+	 * @param x vector (n)
+	 * @param beta scale of y (y is not read if beta = 0)
+	 * @param y vector (m)
+	 */
+	template<typename T>
+	void gemv(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y);
+
+	/**
+	 * Transposed matrix-vector product y = alpha * A' * x + beta * y
+	 * @param m number of rows of A
+	 * @param n number of columns of A
+	 * @param alpha scale of the product
+	 * @param a matrix A (m x n)
+	 * @param lda leading dimension of A (row stride)
+	 * @param x vector (m)
+	 * @param beta scale of y (y is not read if beta = 0)
+	 * @param y vector (n)
+	 */
+	template<typename T>
+	void gemvT(size_t m, size_t n, T alpha, const T* a, size_t lda, const T* x, T beta, T* y);
+
+	/**
+	 * Rank one update A = A + alpha * x * y'
+	 * @param m number of rows of A
+	 * @param n number of columns of A
+	 * @param alpha scale of the product
+	 * @param x vector (m)
+	 * @param y vector (n)
+	 * @param a matrix A (m x n)
+	 * @param lda leading dimension of A (row stride)
+	 */
+	template<typename T>
+	void ger(size_t m, size_t n, T alpha, const T* x, const T* y, T* a, size_t lda);
+
+	/**
+	 * Vector update y = alpha * x + y
+	 * @param n number of values
+	 * @param alpha scale of x
+	 * @param x vector (n)
+	 * @param y vector (n)
+	 */
+	template<typename T>
+	void axpy(size_t n, T alpha, const T* x, T* y);
+
+	/**
+	 * Element-wise product y = x .* y
+	 * @param n number of values
+	 * @param x vector (n)
+	 * @param y vector (n)
+	 */
+	template<typename T>
+	void mul(size_t n, const T* x, T* y);
+
+	/**
+	 * Sparse matrix-vector product y = alpha * A * x + beta * y
+	 * @param m number of rows of A
+	 * @param alpha scale of the product
+	 * @param values values of A
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x vector (columns of A)
+	 * @param beta scale of y (y is not read if beta = 0)
+	 * @param y vector (m)
+	 */
+	template<typename T>
+	void spmv(size_t m, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, T beta, T* y);
+
+	/**
+	 * Transposed sparse matrix-vector product y = alpha * A' * x + beta * y
+	 * @param m number of rows of A
+	 * @param n number of columns of A
+	 * @param alpha scale of the product
+	 * @param values values of A
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x vector (m)
+	 * @param beta scale of y (y is not read if beta = 0)
+	 * @param y vector (n)
+	 */
+	template<typename T>
+	void spmvT(size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, T beta, T* y);
+
+	/**
+	 * Dense-sparse product Y = alpha * X * A' + beta * Y
+	 * The rows of X are packed by SIMD width (transposed): each link is one vector product
+	 * for as many rows of X
+	 * @param rowsCount number of rows of X and Y
+	 * @param m number of rows of A (columns of Y)
+	 * @param n number of columns of A (columns of X)
+	 * @param alpha scale of the product
+	 * @param values values of A
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x matrix X (rowsCount x n)
+	 * @param ldx leading dimension of X (row stride)
+	 * @param beta scale of Y (Y is not read if beta = 0)
+	 * @param y matrix Y (rowsCount x m)
+	 * @param ldy leading dimension of Y (row stride)
+	 */
+	template<typename T>
+	void spmm(size_t rowsCount, size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, T beta, T* y, size_t ldy);
+
+	/**
+	 * Dense-sparse product Y = alpha * X * A + beta * Y
+	 * @param rowsCount number of rows of X and Y
+	 * @param m number of rows of A (columns of X)
+	 * @param n number of columns of A (columns of Y)
+	 * @param alpha scale of the product
+	 * @param values values of A
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x matrix X (rowsCount x m)
+	 * @param ldx leading dimension of X (row stride)
+	 * @param beta scale of Y (Y is not read if beta = 0)
+	 * @param y matrix Y (rowsCount x n)
+	 * @param ldy leading dimension of Y (row stride)
+	 */
+	template<typename T>
+	void spmmT(size_t rowsCount, size_t m, size_t n, T alpha, const T* values, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, T beta, T* y, size_t ldy);
+
+	/**
+	 * Dense-dense product sampled by the links of a sparse matrix A = alpha * X' * Y + beta * A
+	 * (only the values of A are computed: the gradients of sparse weights)
+	 * Blocks of rows of X and Y are packed by column: each link is one vector dot product
+	 * @param rowsCount number of rows of X and Y
+	 * @param m number of rows of A (columns of X)
+	 * @param n number of columns of A (columns of Y)
+	 * @param alpha scale of the product
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x matrix X (rowsCount x m)
+	 * @param ldx leading dimension of X (row stride)
+	 * @param y matrix Y (rowsCount x n)
+	 * @param ldy leading dimension of Y (row stride)
+	 * @param beta scale of A (A is not read if beta = 0)
+	 * @param values values of A
+	 */
+	template<typename T>
+	void sddmm(size_t rowsCount, size_t m, size_t n, T alpha, const unsigned int* rowOffsets, const unsigned int* columns, const T* x, size_t ldx, const T* y, size_t ldy, T beta, T* values);
+
+	/**
+	 * Number of columns of the int8 matrices are padded to a multiple of this block (with zeros)
+	 */
+	const size_t INT8_BLOCK = 64;
+
+	/**
+	 * Quantized matrix-vector product y = A * x (int8 x int8 -> int32)
+	 * VNNI (vpdpbusd) with AVX-512 VNNI, vpmaddubsw with AVX2, values must be in [-127, 127]
+	 * @param m number of rows of A
+	 * @param n number of columns of A (multiple of INT8_BLOCK)
+	 * @param a matrix A (m x n)
+	 * @param lda leading dimension of A (row stride)
+	 * @param x vector (n)
+	 * @param rowSums sums of the rows of A (m)
+	 * @param y vector (m)
+	 */
+	void gemvInt8(size_t m, size_t n, const int8_t* a, size_t lda, const int8_t* x, const int32_t* rowSums, int32_t* y);
+
+	/**
+	 * Quantized sparse matrix-vector product y = A * x (int8 x int8 -> int32)
+	 * @param m number of rows of A
+	 * @param values quantized values of A
+	 * @param rowOffsets first value of each row (m + 1)
+	 * @param columns column of each value
+	 * @param x vector (columns of A)
+	 * @param y vector (m)
+	 */
+	void spmvInt8(size_t m, const int8_t* values, const unsigned int* rowOffsets, const unsigned int* columns, const int8_t* x, int32_t* y);
+
+}
+
+#endif /* KERNEL_KERNEL_HPP_ */
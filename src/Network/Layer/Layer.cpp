@@ -0,0 +1,581 @@
+/*
+ * Layer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "Layer.hpp"
+#include "../Kernel/Kernel.hpp"
+
+#include "../Functions/Excitation/ExcitationKernel.hpp"
+
+namespace {
+
+	/**
+	 * Neurals computed by block: the values of a block are excited while they are in L1
+	 */
+	const size_t FORWARD_BLOCK = 64;
+
+	/**
+	 * Forward propagation of one sample with the excitation known at compile time
+	 * (derivatives can be null when they are not needed, rowOffsets and columns are null
+	 * when the weights are dense)
+	 */
+	template<ExcitationType E, typename T>
+	void forwardKernel(const T* weights, const unsigned int* rowOffsets, const unsigned int* columns, const T* biases, const T* previous, T* inputs, T* outputs, T* derivatives, size_t neuralsCount, size_t inputsCount) {
+		for (size_t first = 0; first < neuralsCount; first += FORWARD_BLOCK) {
+			size_t count = std::min(FORWARD_BLOCK, neuralsCount - first);
+
+			// z = W * previous + b, y = f(z) (and f'(z))
+			if (rowOffsets) {
+				Kernel::spmv<T>(count, 1, weights, rowOffsets + first, columns, previous, 0, inputs + first);
+			} else {
+				Kernel::gemv<T>(count, inputsCount, 1, weights + first * inputsCount, inputsCount, previous, 0, inputs + first);
+			}
+			if (derivatives) {
+				ExcitationKernel::computeBiased<E>(biases + first, inputs + first, outputs + first, derivatives + first, 1, count);
+			} else {
+				ExcitationKernel::computeBiased<E>(biases + first, inputs + first, outputs + first, 1, count);
+			}
+		}
+	}
+
+	/**
+	 * Forward propagation of one sample (one dispatch of the excitation for the layer)
+	 */
+	template<typename T>
+	void forward(ExcitationType eT, const T* weights, const unsigned int* rowOffsets, const unsigned int* columns, const T* biases, const T* previous, T* inputs, T* outputs, T* derivatives, size_t neuralsCount, size_t inputsCount) {
+		switch (eT) {
+		case ExcitationType::NO_EXC:
+			forwardKernel<ExcitationType::NO_EXC>(weights, rowOffsets, columns, biases, previous, inputs, outputs, derivatives, neuralsCount, inputsCount);
+			break;
+		case ExcitationType::SIGMOID:
+			forwardKernel<ExcitationType::SIGMOID>(weights, rowOffsets, columns, biases, previous, inputs, outputs, derivatives, neuralsCount, inputsCount);
+			break;
+		case ExcitationType::STEP:
+			forwardKernel<ExcitationType::STEP>(weights, rowOffsets, columns, biases, previous, inputs, outputs, derivatives, neuralsCount, inputsCount);
+			break;
+		case ExcitationType::TAN_HYP:
+			forwardKernel<ExcitationType::TAN_HYP>(weights, rowOffsets, columns, biases, previous, inputs, outputs, derivatives, neuralsCount, inputsCount);
+			break;
+		case ExcitationType::SOFTMAX:
+			// Normalized over the layer: every block is aggregated first
+			forwardKernel<ExcitationType::NO_EXC, T>(weights, rowOffsets, columns, biases, previous, inputs, inputs, nullptr, neuralsCount, inputsCount);
+			ExcitationKernel::softmax(inputs, outputs, neuralsCount);
+			if (derivatives) {
+				ExcitationKernel::derivative(ExcitationType::SOFTMAX, inputs, derivatives, neuralsCount);
+			}
+			break;
+		}
+	}
+
+}
+
+template<typename T>
+Layer<T>::Layer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection) : connection(connection) {
+	type = t;
+	neuralsCount = nbN;
+	inputsCount = 0;
+	weights = nullptr;
+	biases = nullptr;
+	aggregationType = aT;
+	excitationType = eT;
+
+	// Contiguous buffers of the neurals (taken from the arena of the network)
+	inputValues = nullptr;
+	outputValues = nullptr;
+	deltas = nullptr;
+	derivatives = nullptr;
+	linksGradients = nullptr;
+}
+
+template<typename T>
+void Layer<T>::setLinks(unsigned int previousNeuralsCount, std::mt19937_64& generator) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be connected");
+	}
+
+	// Compressed sparse rows of the connection (nothing if full)
+	inputsCount = previousNeuralsCount;
+	connection.build(neuralsCount, inputsCount, generator, rowOffsets, columns);
+}
+
+template<typename T>
+void Layer<T>::setLinks(unsigned int previousNeuralsCount, std::vector<unsigned int> rowOffsets, std::vector<unsigned int> columns) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be connected");
+	}
+
+	// Increasing offsets, sorted columns of the previous layer in each row (none if full)
+	if (rowOffsets.empty() && columns.empty()) {
+		inputsCount = previousNeuralsCount;
+		this->rowOffsets.clear();
+		this->columns.clear();
+		return;
+	}
+	if (rowOffsets.size() != (size_t) neuralsCount + 1 || rowOffsets.front() != 0 || rowOffsets.back() != columns.size()) {
+		throw std::invalid_argument("The row offsets do not match the links");
+	}
+	for (size_t i = 0; i < neuralsCount; ++i) {
+		if (rowOffsets[i] > rowOffsets[i + 1]) {
+			throw std::invalid_argument("The row offsets should be increasing");
+		}
+		for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+			if (columns[p] >= previousNeuralsCount || (p > rowOffsets[i] && columns[p] <= columns[p - 1])) {
+				throw std::invalid_argument("The columns should be sorted neurals of the previous layer");
+			}
+		}
+	}
+
+	inputsCount = previousNeuralsCount;
+	this->rowOffsets = std::move(rowOffsets);
+	this->columns = std::move(columns);
+}
+
+template<typename T>
+size_t Layer<T>::getParametersCount() const {
+	return Arena<T>::align(getLinksCount()) + Arena<T>::align(neuralsCount);
+}
+
+template<typename T>
+size_t Layer<T>::getBuffersCount() const {
+	return 4 * Arena<T>::align(neuralsCount) + (isSparse() ? Arena<T>::align(getLinksCount()) : 0);
+}
+
+template<typename T>
+void Layer<T>::connect(Arena<T>& arena, std::mt19937_64& generator) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be connected");
+	}
+
+	// Weights and biases taken from the arena
+	size_t linksCount = getLinksCount();
+	T* weights = arena.allocate(linksCount);
+	T* biases = arena.allocate(neuralsCount);
+	connect(weights, biases);
+
+	// Zero-centered random weights (Glorot): uniform in [-l, l], l = sqrt(6 / (fanIn + fanOut)),
+	// with the mean links by neural and by input for sparse weights, and zero biases
+	double fanIn = linksCount / (double) std::max(neuralsCount, 1u);
+	double fanOut = linksCount / (double) std::max(inputsCount, 1u);
+	double limit = (fanIn + fanOut > 0) ? std::sqrt(6 / (fanIn + fanOut)) : 0;
+	std::uniform_real_distribution<double> distribution(-limit, limit);
+	for (size_t i = 0; i < linksCount; ++i) {
+		weights[i] = (T) distribution(generator);
+	}
+	std::fill(biases, biases + neuralsCount, (T) 0);
+}
+
+template<typename T>
+void Layer<T>::connect(T* weights, T* biases) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be connected");
+	}
+
+	this->weights = weights;
+	this->biases = biases;
+}
+
+template<typename T>
+void Layer<T>::setParameters(const T* weights, const T* biases) {
+	std::copy(weights, weights + getLinksCount(), this->weights);
+	std::copy(biases, biases + neuralsCount, this->biases);
+}
+
+template<typename T>
+void Layer<T>::allocate(Arena<T>& arena) {
+	inputValues = arena.allocate(neuralsCount);
+	outputValues = arena.allocate(neuralsCount);
+	deltas = arena.allocate(neuralsCount);
+	derivatives = arena.allocate(neuralsCount);
+	linksGradients = isSparse() ? arena.allocate(getLinksCount()) : nullptr;
+}
+
+template<typename T>
+void Layer<T>::setValues(const std::vector<T>& values) {
+	if (type != NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Only input layer can be set");
+	}
+
+	for (size_t i = 0; i < neuralsCount; ++i) {
+		outputValues[i] = values[i];
+	}
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const Layer<T>& previous) {
+	forwardPropagation(previous, 0, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const Layer<T>& previous, size_t first, size_t last) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+	if (excitationType == ExcitationType::SOFTMAX && (first != 0 || last != neuralsCount)) {
+		throw std::logic_error("A softmax layer can only be computed as a whole");
+	}
+	size_t count = last - first;
+
+	// Without aggregation, only the excitation
+	if (aggregationType == AggregationType::NO_AGG) {
+		ExcitationKernel::compute(excitationType, inputValues + first, outputValues + first, count);
+		ExcitationKernel::derivative(excitationType, inputValues + first, derivatives + first, count);
+		return;
+	}
+
+	// Compute aggregation, excitation and derivatives (one dispatch for the range, the rows of
+	// sparse weights are found by their offsets)
+	const unsigned int* layerRowOffsets = getRowOffsetsData();
+	const T* rangeWeights = layerRowOffsets ? weights : weights + first * inputsCount;
+	const unsigned int* rangeRowOffsets = layerRowOffsets ? layerRowOffsets + first : nullptr;
+	forward(excitationType, rangeWeights, rangeRowOffsets, getColumnsData(), biases + first, previous.outputValues, inputValues + first, outputValues + first, derivatives + first, count, inputsCount);
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const T* previous, T* inputs, T* outputs) const {
+	forwardPropagation(previous, inputs, outputs, 0, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const T* previous, T* inputs, T* outputs, size_t first, size_t last) const {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+	if (excitationType == ExcitationType::SOFTMAX && (first != 0 || last != neuralsCount)) {
+		throw std::logic_error("A softmax layer can only be computed as a whole");
+	}
+	size_t count = last - first;
+
+	// Without aggregation, only the excitation
+	if (aggregationType == AggregationType::NO_AGG) {
+		ExcitationKernel::compute(excitationType, inputs + first, outputs + first, count);
+		return;
+	}
+
+	// Compute aggregation and excitation (one dispatch for the range)
+	const unsigned int* layerRowOffsets = getRowOffsetsData();
+	const T* rangeWeights = layerRowOffsets ? weights : weights + first * inputsCount;
+	const unsigned int* rangeRowOffsets = layerRowOffsets ? layerRowOffsets + first : nullptr;
+	forward<T>(excitationType, rangeWeights, rangeRowOffsets, getColumnsData(), biases + first, previous, inputs + first, outputs + first, nullptr, count, inputsCount);
+}
+
+template<typename T>
+void Layer<T>::aggregate(const Layer<T>& previous) {
+	aggregate(previous, 0, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::aggregate(const Layer<T>& previous, size_t first, size_t last) {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+
+	// Without aggregation, the input values as they are
+	if (aggregationType == AggregationType::NO_AGG) {
+		return;
+	}
+
+	// Compute aggregation W * previous
+	if (isSparse()) {
+		Kernel::spmv<T>(last - first, 1, weights, rowOffsets.data() + first, columns.data(), previous.outputValues, 0, inputValues + first);
+	} else {
+		Kernel::gemv<T>(last - first, inputsCount, 1, weights + first * inputsCount, inputsCount, previous.outputValues, 0, inputValues + first);
+	}
+}
+
+template<typename T>
+T Layer<T>::computeDeltaOutput(const std::vector<T>& expectedValues, const Loss<T>& loss) {
+	if (type != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("Only output layer can compute delta output");
+	}
+
+	// Biases (none without aggregation), excitation, deltas and loss in one pass
+	std::vector<T> noBiases;
+	const T* layerBiases = biases;
+	if (aggregationType == AggregationType::NO_AGG) {
+		noBiases.assign(neuralsCount, 0);
+		layerBiases = noBiases.data();
+	}
+	return loss.compute(excitationType, layerBiases, inputValues, expectedValues.data(), neuralsCount, outputValues, deltas, 1, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::computeDeltas(const Layer<T>& next) {
+	computeDeltas(next, 0, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::computeDeltas(const Layer<T>& next, size_t first, size_t last) {
+	size_t count = last - first;
+
+	// Sum of links errors: transposed weights of the next layer * next deltas (the columns of
+	// sparse weights are scattered: only as a whole)
+	if (next.isSparse()) {
+		if (first != 0 || last != neuralsCount) {
+			throw std::logic_error("The deltas before a sparse layer can only be computed as a whole");
+		}
+		Kernel::spmvT<T>(next.neuralsCount, next.inputsCount, 1, next.weights, next.rowOffsets.data(), next.columns.data(), next.deltas, 0, deltas);
+	} else {
+		Kernel::gemvT<T>(next.neuralsCount, count, 1, next.weights + first, next.inputsCount, next.deltas, 0, deltas + first);
+	}
+
+	// Compute delta f'(value) * sum(delta * w)[n+1]
+	Kernel::mul<T>(count, derivatives + first, deltas + first);
+}
+
+template<typename T>
+void Layer<T>::computeWeights(const Layer<T>& previous, Optimizer<T>& optimizer, size_t offset, T learningRate) {
+	computeWeights(previous, optimizer, offset, learningRate, 0, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::computeWeights(const Layer<T>& previous, Optimizer<T>& optimizer, size_t offset, T learningRate, size_t first, size_t last) {
+	if (isSparse()) {
+		// J'(w) = delta * z' of the links of the range (gathered), one update for the range
+		size_t firstLink = rowOffsets[first];
+		Kernel::sddmm<T>(1, last - first, inputsCount, 1, rowOffsets.data() + first, columns.data(), deltas + first, neuralsCount, previous.outputValues, inputsCount, 0, linksGradients);
+		optimizer.update(offset + firstLink, weights + firstLink, linksGradients + firstLink, 1, learningRate, rowOffsets[last] - firstLink);
+	} else {
+		// J'(w) = delta * z', one update by row of weights
+		for (size_t r = first; r < last; ++r) {
+			optimizer.update(offset + r * inputsCount, weights + r * inputsCount, previous.outputValues, deltas[r], learningRate, inputsCount);
+		}
+	}
+
+	// J'(b) = delta, the biases follow the weights in the parameters
+	optimizer.update(offset + Arena<T>::align(getLinksCount()) + first, biases + first, deltas + first, 1, learningRate, last - first);
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const Matrix<T>& previous, Matrix<T>& inputs, Matrix<T>& outputs) const {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+
+	size_t batchSize = previous.getRowsCount();
+
+	// Without aggregation, only the excitation (by row)
+	if (aggregationType == AggregationType::NO_AGG) {
+		for (size_t r = 0; r < batchSize; ++r) {
+			ExcitationKernel::compute(excitationType, inputs.row(r), outputs.row(r), neuralsCount);
+		}
+		return;
+	}
+
+	// Compute aggregation (previous * W'), then biases and excitation in one pass
+	aggregate(previous, inputs);
+	ExcitationKernel::computeBiased(excitationType, biases, inputs.data(), outputs.data(), batchSize, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::forwardPropagation(const Matrix<T>& previous, Matrix<T>& inputs, Matrix<T>& outputs, Matrix<T>& derivatives) const {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+
+	size_t batchSize = previous.getRowsCount();
+
+	// Without aggregation, only the excitation (by row)
+	if (aggregationType == AggregationType::NO_AGG) {
+		for (size_t r = 0; r < batchSize; ++r) {
+			ExcitationKernel::compute(excitationType, inputs.row(r), outputs.row(r), neuralsCount);
+			ExcitationKernel::derivative(excitationType, inputs.row(r), derivatives.row(r), neuralsCount);
+		}
+		return;
+	}
+
+	// Compute aggregation (previous * W'), then biases, excitation and derivatives in one pass
+	aggregate(previous, inputs);
+	ExcitationKernel::computeBiased(excitationType, biases, inputs.data(), outputs.data(), derivatives.data(), batchSize, neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::aggregate(const Matrix<T>& previous, Matrix<T>& inputs) const {
+	if (type == NeuralType::INPUT_NEURAL) {
+		throw std::logic_error("Input layer can not be computed");
+	}
+
+	// Without aggregation, the input values as they are
+	if (aggregationType == AggregationType::NO_AGG) {
+		return;
+	}
+
+	// Compute aggregation previous * W'
+	size_t batchSize = previous.getRowsCount();
+	if (isSparse()) {
+		Kernel::spmm<T>(batchSize, neuralsCount, inputsCount, 1, weights, rowOffsets.data(), columns.data(), previous.data(), inputsCount, 0, inputs.data(), neuralsCount);
+	} else {
+		Kernel::gemm<T>(Kernel::Transpose::NO_TRANS, Kernel::Transpose::TRANS, batchSize, neuralsCount, inputsCount,
+			1, previous.data(), inputsCount, weights, inputsCount, 0, inputs.data(), neuralsCount);
+	}
+}
+
+template<typename T>
+T Layer<T>::computeDeltaOutput(const Matrix<T>& expectedValues, const Loss<T>& loss, Matrix<T>& inputs, Matrix<T>& outputs, Matrix<T>& deltas) const {
+	if (type != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("Only output layer can compute delta output");
+	}
+
+	// Biases (none without aggregation), excitation, deltas and loss in one pass over each row
+	std::vector<T> noBiases;
+	const T* layerBiases = biases;
+	if (aggregationType == AggregationType::NO_AGG) {
+		noBiases.assign(neuralsCount, 0);
+		layerBiases = noBiases.data();
+	}
+	return loss.compute(excitationType, layerBiases, inputs.data(), expectedValues.data(), expectedValues.getColsCount(), outputs.data(), deltas.data(), inputs.getRowsCount(), neuralsCount);
+}
+
+template<typename T>
+void Layer<T>::computeDeltas(const Layer<T>& next, const Matrix<T>& nextDeltas, const Matrix<T>& derivatives, Matrix<T>& deltas) const {
+	// Sum of links errors: next deltas * weights of the next layer
+	if (next.isSparse()) {
+		Kernel::spmmT<T>(deltas.getRowsCount(), next.neuralsCount, neuralsCount, 1, next.weights, next.rowOffsets.data(), next.columns.data(),
+			nextDeltas.data(), next.neuralsCount, 0, deltas.data(), neuralsCount);
+	} else {
+		Kernel::gemm<T>(Kernel::Transpose::NO_TRANS, Kernel::Transpose::NO_TRANS, deltas.getRowsCount(), neuralsCount, next.neuralsCount,
+			1, nextDeltas.data(), next.neuralsCount, next.weights, next.inputsCount, 0, deltas.data(), neuralsCount);
+	}
+
+	// Compute delta f'(value) * sum(delta * w)[n+1]
+	Kernel::mul<T>(deltas.getRowsCount() * neuralsCount, derivatives.data(), deltas.data());
+}
+
+template<typename T>
+void Layer<T>::computeGradients(const Matrix<T>& previous, const Matrix<T>& deltas, Matrix<T>& weightsGradients, std::vector<T>& biasesGradients) const {
+	// J'(w) = deltas' * z (sum over the batch, only the links of a sparse layer)
+	if (isSparse()) {
+		Kernel::sddmm<T>(deltas.getRowsCount(), neuralsCount, inputsCount, 1, rowOffsets.data(), columns.data(), deltas.data(), neuralsCount,
+			previous.data(), inputsCount, 0, weightsGradients.data());
+	} else {
+		Kernel::gemm<T>(Kernel::Transpose::TRANS, Kernel::Transpose::NO_TRANS, neuralsCount, inputsCount, deltas.getRowsCount(),
+			1, deltas.data(), neuralsCount, previous.data(), inputsCount, 0, weightsGradients.data(), inputsCount);
+	}
+	std::fill(biasesGradients.begin(), biasesGradients.end(), (T) 0);
+	for (size_t r = 0; r < deltas.getRowsCount(); ++r) {
+		Kernel::axpy<T>(neuralsCount, 1, deltas.row(r), biasesGradients.data());
+	}
+}
+
+template<typename T>
+void Layer<T>::applyGradients(const Matrix<T>& weightsGradients, const std::vector<T>& biasesGradients, T scale, Optimizer<T>& optimizer, size_t offset, T learningRate) {
+	// Weights then biases (as laid out in the parameters)
+	optimizer.update(offset, weights, weightsGradients.data(), scale, learningRate, getLinksCount());
+	optimizer.update(offset + Arena<T>::align(getLinksCount()), biases, biasesGradients.data(), scale, learningRate, neuralsCount);
+}
+
+template<typename T>
+NeuralType Layer<T>::getType() const {
+	return type;
+}
+
+template<typename T>
+AggregationType Layer<T>::getAggregationType() const {
+	return aggregationType;
+}
+
+template<typename T>
+ExcitationType Layer<T>::getExcitationType() const {
+	return excitationType;
+}
+
+template<typename T>
+unsigned int Layer<T>::getNeuralsCount() const {
+	return neuralsCount;
+}
+
+template<typename T>
+unsigned int Layer<T>::getInputsCount() const {
+	return inputsCount;
+}
+
+template<typename T>
+size_t Layer<T>::getLinksCount() const {
+	return isSparse() ? columns.size() : (size_t) neuralsCount * inputsCount;
+}
+
+template<typename T>
+bool Layer<T>::isSparse() const {
+	return !rowOffsets.empty();
+}
+
+template<typename T>
+const std::vector<unsigned int>& Layer<T>::getRowOffsets() const {
+	return rowOffsets;
+}
+
+template<typename T>
+const std::vector<unsigned int>& Layer<T>::getColumns() const {
+	return columns;
+}
+
+template<typename T>
+const unsigned int* Layer<T>::getRowOffsetsData() const {
+	return isSparse() ? rowOffsets.data() : nullptr;
+}
+
+template<typename T>
+const unsigned int* Layer<T>::getColumnsData() const {
+	return isSparse() ? columns.data() : nullptr;
+}
+
+template<typename T>
+void Layer<T>::copyWeights(std::vector<T>& denseWeights) const {
+	if (!isSparse()) {
+		denseWeights.assign(weights, weights + getLinksCount());
+		return;
+	}
+	denseWeights.assign((size_t) neuralsCount * inputsCount, 0);
+	for (size_t i = 0; i < neuralsCount; ++i) {
+		for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+			denseWeights[i * inputsCount + columns[p]] = weights[p];
+		}
+	}
+}
+
+template<typename T>
+const T* Layer<T>::getWeights() const {
+	return weights;
+}
+
+template<typename T>
+const T* Layer<T>::getBiases() const {
+	return biases;
+}
+
+template<typename T>
+const T* Layer<T>::getOutputValues() const {
+	return outputValues;
+}
+
+template<typename T>
+std::string Layer<T>::toString() const {
+	std::string s;
+	for (size_t i = 0; i < neuralsCount; ++i) {
+		// Return bias value if is present
+		s += std::to_string(outputValues[i]);
+		if (biases) {
+			s += "(" + std::to_string(biases[i]) + ")";
+		}
+		s += " ";
+	}
+	return s;
+}
+
+template<typename T>
+std::string Layer<T>::linksToString() const {
+	std::string s;
+	for (size_t i = 0; i < getLinksCount(); ++i) {
+		s += std::to_string(weights[i]) + " ";
+	}
+	return s;
+}
+
+template class Layer<float>;
+template class Layer<double>;
@@ -0,0 +1,464 @@
+/*
+ * Layer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef LAYER_LAYER_HPP_
+#define LAYER_LAYER_HPP_
+
+#include <vector>
+#include <string>
+#include <random>
+
+#include "../../constant.h"
+
+#include "../Matrix/Matrix.hpp"
+#include "../Arena/Arena.hpp"
+#include "../Connection/Connection.hpp"
+#include "../Functions/Loss/Loss.hpp"
+#include "../Functions/Optimizer/Optimizer.hpp"
+
+/**
+ * Representation of one layer of the network
+ *
+ * The layer uses the weights of the links coming from the previous layer as one
+ * row-major matrix (one row by neural, one column by neural of the previous layer) or,
+ * for a sparse connection, as the values of compressed sparse rows (the links of a neural
+ * are contiguous, see Connection), the biases and the contiguous buffers of values and
+ * deltas of its neurals; all these arrays are taken from the arena of the network (or from
+ * a mapped model file)
+ *
+ * The excitation type is dispatched once by call of a kernel of the layer: the excitation
+ * is inlined in the loops over the neurals (no virtual call by neural or by value). The
+ * forward propagation of the learning caches f'(value) next to the output values: the
+ * backward propagation only multiplies cached buffers (no exponential)
+ */
+template<typename T>
+class Layer {
+protected:
+	/**
+	 * Type of the neurals
+	 */
+	NeuralType type;
+
+	/**
+	 * Number of neurals
+	 */
+	unsigned int neuralsCount;
+
+	/**
+	 * Number of neurals of the previous layer
+	 */
+	unsigned int inputsCount;
+
+	/**
+	 * Aggregation type
+	 */
+	AggregationType aggregationType;
+
+	/**
+	 * Excitation type
+	 */
+	ExcitationType excitationType;
+
+	/**
+	 * Links with the previous layer
+	 */
+	Connection connection;
+
+	/**
+	 * First link of each neural (neuralsCount + 1, empty if the weights are dense)
+	 */
+	std::vector<unsigned int> rowOffsets;
+
+	/**
+	 * Neural of the previous layer of each link (empty if the weights are dense)
+	 */
+	std::vector<unsigned int> columns;
+
+	/**
+	 * Weights matrix (neuralsCount x inputsCount, or the values of the links if sparse)
+	 */
+	T* weights;
+
+	/**
+	 * Biases (neuralsCount)
+	 */
+	T* biases;
+
+	/**
+	 * Neurals input values (neuralsCount)
+	 */
+	T* inputValues;
+
+	/**
+	 * Neurals output values (neuralsCount)
+	 */
+	T* outputValues;
+
+	/**
+	 * Neurals deltas (neuralsCount)
+	 */
+	T* deltas;
+
+	/**
+	 * Neurals derivatives f'(value) cached by the forward propagation of the learning (neuralsCount)
+	 */
+	T* derivatives;
+
+	/**
+	 * Gradients of the links of the single-sample learning (linksCount, null if the weights are dense)
+	 */
+	T* linksGradients;
+
+protected:
+	/**
+	 * Get the compressed sparse rows of the kernels
+	 * @return row offsets or columns (null if the weights are dense)
+	 */
+	const unsigned int* getRowOffsetsData() const;
+	const unsigned int* getColumnsData() const;
+
+public:
+	/**
+	 * Constructor
+	 * @param t neural type
+	 * @param nbN number of neurals
+	 * @param aT aggregation type
+	 * @param eT excitation type
+	 * @param connection links with the previous layer
+	 */
+	Layer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection = Connection());
+
+	/**
+	 * Set the links coming from the previous layer (built from the connection of the layer)
+	 * @param previousNeuralsCount number of neurals of the previous layer
+	 * @param generator random generator of the network (random connection)
+	 * @throw logic_error input layer can not be connected
+	 * @throw invalid_argument if the connection does not match the layers
+	 */
+	void setLinks(unsigned int previousNeuralsCount, std::mt19937_64& generator);
+
+	/**
+	 * Set the links coming from the previous layer as compressed sparse rows (no rows and
+	 * no columns: full connection)
+	 * @param previousNeuralsCount number of neurals of the previous layer
+	 * @param rowOffsets first link of each neural (neuralsCount + 1, starting at 0)
+	 * @param columns neural of the previous layer of each link (sorted in each row, no duplicate)
+	 * @throw logic_error input layer can not be connected
+	 * @throw invalid_argument if the rows are not valid
+	 */
+	void setLinks(unsigned int previousNeuralsCount, std::vector<unsigned int> rowOffsets, std::vector<unsigned int> columns);
+
+	/**
+	 * Get number of values taken in an arena by the weights and the biases (links must be set)
+	 * @return number of values
+	 */
+	size_t getParametersCount() const;
+
+	/**
+	 * Get number of values taken in an arena by the buffers of the neurals
+	 * @return number of values
+	 */
+	size_t getBuffersCount() const;
+
+	/**
+	 * Connect the layer to the previous one (links must be set, weights and biases taken from
+	 * the arena and initialized)
+	 * @param arena arena of the network
+	 * @param generator random generator of the network (initial weights, the biases start at zero)
+	 * @throw logic_error input layer can not be connected
+	 */
+	void connect(Arena<T>& arena, std::mt19937_64& generator);
+
+	/**
+	 * Connect the layer to the previous one with external weights and biases (links must be
+	 * set, not copied: the arrays are used in place and must outlive the layer)
+	 * @param weights weights (linksCount)
+	 * @param biases biases (neuralsCount)
+	 * @throw logic_error input layer can not be connected
+	 */
+	void connect(T* weights, T* biases);
+
+	/**
+	 * Copy weights and biases into the ones of the layer (in the arena or in a mapped file)
+	 * @param weights weights (linksCount)
+	 * @param biases biases (neuralsCount)
+	 */
+	void setParameters(const T* weights, const T* biases);
+
+	/**
+	 * Take the buffers of the neurals (values, deltas and derivatives) and of the gradients of sparse links from the arena
+	 * @param arena arena of the network
+	 */
+	void allocate(Arena<T>& arena);
+
+	/**
+	 * Set values of the neurals (only input layer can be set)
+	 * @param values values of the neurals (at least neuralsCount)
+	 * @throw logic_error if the layer is not an input layer
+	 */
+	void setValues(const std::vector<T>& values);
+
+	/**
+	 * Compute forward propagation: f(W * previous + b) and the derivatives f'(W * previous + b)
+	 * @param previous previous layer
+	 * @throw logic_error input layer can not be computed
+	 */
+	void forwardPropagation(const Layer& previous);
+
+	/**
+	 * Compute forward propagation of the neurals first .. last - 1 (the ranges of a layer can be
+	 * computed by several threads)
+	 * @param previous previous layer
+	 * @param first first neural
+	 * @param last end of the neurals
+	 * @throw logic_error input layer can not be computed, a softmax layer only as a whole
+	 */
+	void forwardPropagation(const Layer& previous, size_t first, size_t last);
+
+	/**
+	 * Compute forward propagation of one sample in external buffers (weights are only read)
+	 * @param previous output values of the previous layer (inputsCount)
+	 * @param inputs input values of the neurals (neuralsCount)
+	 * @param outputs output values of the neurals (neuralsCount)
+	 * @throw logic_error input layer can not be computed
+	 */
+	void forwardPropagation(const T* previous, T* inputs, T* outputs) const;
+
+	/**
+	 * Compute forward propagation of one sample for the neurals first .. last - 1
+	 * @param previous output values of the previous layer (inputsCount)
+	 * @param inputs input values of the neurals (neuralsCount)
+	 * @param outputs output values of the neurals (neuralsCount)
+	 * @param first first neural
+	 * @param last end of the neurals
+	 * @throw logic_error input layer can not be computed, a softmax layer only as a whole
+	 */
+	void forwardPropagation(const T* previous, T* inputs, T* outputs, size_t first, size_t last) const;
+
+	/**
+	 * Compute aggregation only: W * previous (the biases and the excitation of the output layer
+	 * are computed with the loss, see computeDeltaOutput)
+	 * @param previous previous layer
+	 * @throw logic_error input layer can not be computed
+	 */
+	void aggregate(const Layer& previous);
+
+	/**
+	 * Compute aggregation only of the neurals first .. last - 1
+	 * @param previous previous layer
+	 * @param first first neural
+	 * @param last end of the neurals
+	 * @throw logic_error input layer can not be computed
+	 */
+	void aggregate(const Layer& previous, size_t first, size_t last);
+
+	/**
+	 * Compute outputs, output deltas and loss in one pass over the aggregated values (see Loss)
+	 * @param expectedValues expected values
+	 * @param loss loss function
+	 * @return loss value
+	 * @throw logic_error only output layer can compute delta output
+	 */
+	T computeDeltaOutput(const std::vector<T>& expectedValues, const Loss<T>& loss);
+
+	/**
+	 * Compute deltas f'(value) * sum(w * delta)[n+1]
+	 * @param next next layer (deltas must be already computed)
+	 */
+	void computeDeltas(const Layer& next);
+
+	/**
+	 * Compute deltas of the neurals first .. last - 1 (columns of the weights of the next layer)
+	 * @param next next layer (deltas must be already computed)
+	 * @param first first neural
+	 * @param last end of the neurals
+	 * @throw logic_error the deltas before a sparse layer can only be computed as a whole
+	 */
+	void computeDeltas(const Layer& next, size_t first, size_t last);
+
+	/**
+	 * Compute new weights and biases (the gradient of a row of dense weights is delta * z' of
+	 * the previous layer: it is not stored, the optimizer scales the previous outputs)
+	 * @param previous previous layer
+	 * @param optimizer update rule
+	 * @param offset offset of the weights in the parameters of the network (see getParametersCount)
+	 * @param learningRate alpha value used in weight computation
+	 */
+	void computeWeights(const Layer& previous, Optimizer<T>& optimizer, size_t offset, T learningRate);
+
+	/**
+	 * Compute new weights and biases of the neurals first .. last - 1 (the optimizer updates
+	 * each parameter on its own: the ranges of a layer can be updated by several threads)
+	 * @param previous previous layer
+	 * @param optimizer update rule
+	 * @param offset offset of the weights in the parameters of the network (see getParametersCount)
+	 * @param learningRate alpha value used in weight computation
+	 * @param first first neural
+	 * @param last end of the neurals
+	 */
+	void computeWeights(const Layer& previous, Optimizer<T>& optimizer, size_t offset, T learningRate, size_t first, size_t last);
+
+	/**
+	 * Compute forward propagation of a batch: f(previous * W' + b)
+	 * @param previous output values of the previous layer (batchSize x inputsCount)
+	 * @param inputs input values of the neurals (batchSize x neuralsCount)
+	 * @param outputs output values of the neurals (batchSize x neuralsCount)
+	 * @throw logic_error input layer can not be computed
+	 */
+	void forwardPropagation(const Matrix<T>& previous, Matrix<T>& inputs, Matrix<T>& outputs) const;
+
+	/**
+	 * Compute forward propagation of a batch and the derivatives used by the backward propagation
+	 * @param previous output values of the previous layer (batchSize x inputsCount)
+	 * @param inputs input values of the neurals (batchSize x neuralsCount)
+	 * @param outputs output values of the neurals (batchSize x neuralsCount)
+	 * @param derivatives derivatives f'(inputs) of the neurals (batchSize x neuralsCount)
+	 * @throw logic_error input layer can not be computed
+	 */
+	void forwardPropagation(const Matrix<T>& previous, Matrix<T>& inputs, Matrix<T>& outputs, Matrix<T>& derivatives) const;
+
+	/**
+	 * Compute aggregation of a batch only: previous * W'
+	 * @param previous output values of the previous layer (batchSize x previous neuralsCount)
+	 * @param inputs input values of the neurals (batchSize x neuralsCount)
+	 * @throw logic_error input layer can not be computed
+	 */
+	void aggregate(const Matrix<T>& previous, Matrix<T>& inputs) const;
+
+	/**
+	 * Compute outputs, output deltas and loss of a batch in one pass over the aggregated values (see Loss)
+	 * @param expectedValues expected values (batchSize x at least neuralsCount)
+	 * @param loss loss function
+	 * @param inputs aggregated values of the neurals (batchSize x neuralsCount), the biases are added
+	 * @param outputs output values of the neurals (batchSize x neuralsCount)
+	 * @param deltas deltas of the neurals (batchSize x neuralsCount)
+	 * @return loss value (mean of the batch)
+	 * @throw logic_error only output layer can compute delta output
+	 */
+	T computeDeltaOutput(const Matrix<T>& expectedValues, const Loss<T>& loss, Matrix<T>& inputs, Matrix<T>& outputs, Matrix<T>& deltas) const;
+
+	/**
+	 * Compute deltas of a batch f'(value) * (deltas[n+1] * W[n+1])
+	 * @param next next layer
+	 * @param nextDeltas deltas of the next layer (batchSize x next neuralsCount)
+	 * @param derivatives derivatives of the neurals cached by the forward propagation (batchSize x neuralsCount)
+	 * @param deltas deltas of the neurals (batchSize x neuralsCount)
+	 */
+	void computeDeltas(const Layer& next, const Matrix<T>& nextDeltas, const Matrix<T>& derivatives, Matrix<T>& deltas) const;
+
+	/**
+	 * Compute gradients accumulated over a batch: deltas' * previous and sum(deltas)
+	 * @param previous output values of the previous layer (batchSize x inputsCount)
+	 * @param deltas deltas of the neurals (batchSize x neuralsCount)
+	 * @param weightsGradients weights gradients (neuralsCount x inputsCount, 1 x linksCount if sparse)
+	 * @param biasesGradients biases gradients (neuralsCount)
+	 */
+	void computeGradients(const Matrix<T>& previous, const Matrix<T>& deltas, Matrix<T>& weightsGradients, std::vector<T>& biasesGradients) const;
+
+	/**
+	 * Apply gradients with an optimizer (J'(w) = scale * gradients)
+	 * @param weightsGradients weights gradients (neuralsCount x inputsCount, 1 x linksCount if sparse)
+	 * @param biasesGradients biases gradients (neuralsCount)
+	 * @param scale factor of the gradients (1 / batchSize for the mean gradient)
+	 * @param optimizer update rule
+	 * @param offset offset of the weights in the parameters of the network (see getParametersCount)
+	 * @param learningRate alpha value used in weight computation
+	 */
+	void applyGradients(const Matrix<T>& weightsGradients, const std::vector<T>& biasesGradients, T scale, Optimizer<T>& optimizer, size_t offset, T learningRate);
+
+	/**
+	 * Get neural type
+	 * @return neural type
+	 */
+	NeuralType getType() const;
+
+	/**
+	 * Get aggregation type
+	 * @return aggregation type
+	 */
+	AggregationType getAggregationType() const;
+
+	/**
+	 * Get excitation type
+	 * @return excitation type
+	 */
+	ExcitationType getExcitationType() const;
+
+	/**
+	 * Get number of neurals
+	 * @return number of neurals
+	 */
+	unsigned int getNeuralsCount() const;
+
+	/**
+	 * Get number of neurals of the previous layer
+	 * @return number of inputs
+	 */
+	unsigned int getInputsCount() const;
+
+	/**
+	 * Get number of links coming from the previous layer
+	 * @return number of links
+	 */
+	size_t getLinksCount() const;
+
+	/**
+	 * Are the weights stored as compressed sparse rows
+	 * @return true if the layer is sparse
+	 */
+	bool isSparse() const;
+
+	/**
+	 * Get first link of each neural of a sparse layer
+	 * @return row offsets (neuralsCount + 1, empty if dense)
+	 */
+	const std::vector<unsigned int>& getRowOffsets() const;
+
+	/**
+	 * Get neural of the previous layer of each link of a sparse layer
+	 * @return columns (linksCount, empty if dense)
+	 */
+	const std::vector<unsigned int>& getColumns() const;
+
+	/**
+	 * Copy the weights as a dense matrix (zero if there is no link)
+	 * @param denseWeights weights (neuralsCount x inputsCount)
+	 */
+	void copyWeights(std::vector<T>& denseWeights) const;
+
+	/**
+	 * Get weights
+	 * @return weights (neuralsCount x inputsCount or linksCount if sparse, null if the layer is not connected)
+	 */
+	const T* getWeights() const;
+
+	/**
+	 * Get biases
+	 * @return biases (neuralsCount, null if the layer is not connected)
+	 */
+	const T* getBiases() const;
+
+	/**
+	 * Get neurals output values
+	 * @return output values (neuralsCount, null if the buffers are not allocated)
+	 */
+	const T* getOutputValues() const;
+
+	/**
+	 * To string
+	 * @return neurals in string
+	 */
+	std::string toString() const;
+
+	/**
+	 * Links to string
+	 * @return weights in string
+	 */
+	std::string linksToString() const;
+};
+
+#endif /* LAYER_LAYER_HPP_ */
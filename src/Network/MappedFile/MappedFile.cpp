@@ -0,0 +1,104 @@
+/*
+ * MappedFile.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "MappedFile.hpp"
+
+#if defined(_WIN32)
+
+MappedFile::MappedFile(const std::string& path) {
+	address = nullptr;
+	size = 0;
+	fileHandle = INVALID_HANDLE_VALUE;
+	mappingHandle = nullptr;
+
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE) {
+		throw std::runtime_error("Can not open " + path);
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize)) {
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Can not get the size of " + path);
+	}
+	size = (size_t) fileSize.QuadPart;
+	if (size == 0) {
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Empty file " + path);
+	}
+
+	// Copy-on-write view
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	if (mappingHandle) {
+		address = MapViewOfFile(mappingHandle, FILE_MAP_COPY, 0, 0, 0);
+	}
+	if (!address) {
+		if (mappingHandle) {
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+		throw std::runtime_error("Can not map " + path);
+	}
+}
+
+MappedFile::~MappedFile() {
+	UnmapViewOfFile(address);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) {
+	address = nullptr;
+	size = 0;
+
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		throw std::runtime_error("Can not open " + path);
+	}
+	struct stat status;
+	if (fstat(fd, &status) != 0) {
+		close(fd);
+		throw std::runtime_error("Can not get the size of " + path);
+	}
+	size = (size_t) status.st_size;
+	if (size == 0) {
+		close(fd);
+		throw std::runtime_error("Empty file " + path);
+	}
+
+	// Copy-on-write mapping (the file descriptor is not needed by the mapping)
+	void* p = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED) {
+		throw std::runtime_error("Can not map " + path);
+	}
+	address = p;
+}
+
+MappedFile::~MappedFile() {
+	munmap(address, size);
+}
+
+#endif
+
+size_t MappedFile::getSize() const {
+	return size;
+}
@@ -0,0 +1,70 @@
+/*
+ * MappedFile.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef MAPPEDFILE_MAPPEDFILE_HPP_
+#define MAPPEDFILE_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+/**
+ * File mapped in memory (mmap or CreateFileMapping)
+ *
+ * The mapping is private copy-on-write: pages are shared with every process mapping the
+ * same file until they are written, writes are never stored in the file
+ */
+class MappedFile {
+protected:
+	/**
+	 * First byte of the mapping
+	 */
+	void* address;
+
+	/**
+	 * Size of the file
+	 */
+	size_t size;
+
+#if defined(_WIN32)
+	/**
+	 * Handles of the file and of the mapping
+	 */
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+
+public:
+	/**
+	 * Constructor: map the whole file
+	 * @param path path of the file
+	 * @throw runtime_error if the file can not be mapped
+	 */
+	MappedFile(const std::string& path);
+
+	/**
+	 * Destructor (unmap the file)
+	 */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/**
+	 * Get mapped bytes
+	 * @return pointer to the first byte
+	 */
+	unsigned char* data() { return static_cast<unsigned char*>(address); }
+	const unsigned char* data() const { return static_cast<const unsigned char*>(address); }
+
+	/**
+	 * Get size of the file
+	 * @return size in bytes
+	 */
+	size_t getSize() const;
+};
+
+#endif /* MAPPEDFILE_MAPPEDFILE_HPP_ */
@@ -0,0 +1,32 @@
+/*
+ * Matrix.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <algorithm>
+
+#include "Matrix.hpp"
+
+template<typename T>
+Matrix<T>::Matrix(size_t rows, size_t cols, T v) {
+	rowsCount = rows;
+	colsCount = cols;
+	values.assign(rows * cols, v);
+}
+
+template<typename T>
+void Matrix<T>::resize(size_t rows, size_t cols) {
+	rowsCount = rows;
+	colsCount = cols;
+	values.resize(rows * cols);
+}
+
+template<typename T>
+void Matrix<T>::fill(T v) {
+	std::fill(values.begin(), values.end(), v);
+}
+
+template class Matrix<float>;
+template class Matrix<double>;
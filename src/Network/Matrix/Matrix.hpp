@@ -0,0 +1,96 @@
+/*
+ * Matrix.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef MATRIX_MATRIX_HPP_
+#define MATRIX_MATRIX_HPP_
+
+#include <cstddef>
+#include <vector>
+
+#include "../AlignedAllocator/AlignedAllocator.hpp"
+
+/**
+ * Dense row-major matrix (one row by sample), the first row starts on a cache line
+ */
+template<typename T>
+class Matrix {
+protected:
+	/**
+	 * Number of rows
+	 */
+	size_t rowsCount;
+
+	/**
+	 * Number of columns
+	 */
+	size_t colsCount;
+
+	/**
+	 * Contiguous values (rowsCount x colsCount)
+	 */
+	std::vector<T, AlignedAllocator<T>> values;
+
+public:
+	/**
+	 * Constructor
+	 * @param rows number of rows
+	 * @param cols number of columns
+	 * @param v default value
+	 */
+	Matrix(size_t rows = 0, size_t cols = 0, T v = 0);
+
+	/**
+	 * Resize the matrix (values are not preserved)
+	 * @param rows number of rows
+	 * @param cols number of columns
+	 */
+	void resize(size_t rows, size_t cols);
+
+	/**
+	 * Set all values
+	 * @param v value
+	 */
+	void fill(T v);
+
+	/**
+	 * Get number of rows
+	 * @return number of rows
+	 */
+	size_t getRowsCount() const { return rowsCount; }
+
+	/**
+	 * Get number of columns
+	 * @return number of columns
+	 */
+	size_t getColsCount() const { return colsCount; }
+
+	/**
+	 * Get values
+	 * @return pointer to the first value
+	 */
+	T* data() { return values.data(); }
+	const T* data() const { return values.data(); }
+
+	/**
+	 * Get a row
+	 * @param i row index
+	 * @return pointer to the first value of the row
+	 */
+	T* row(size_t i) { return values.data() + i * colsCount; }
+	const T* row(size_t i) const { return values.data() + i * colsCount; }
+
+	/**
+	 * Get a value
+	 * @param i row index
+	 * @param j column index
+	 * @return value reference
+	 */
+	T& at(size_t i, size_t j) { return values[i * colsCount + j]; }
+	T at(size_t i, size_t j) const { return values[i * colsCount + j]; }
+};
+
+#endif /* MATRIX_MATRIX_HPP_ */
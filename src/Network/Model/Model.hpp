@@ -0,0 +1,90 @@
+/*
+ * Model.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef MODEL_MODEL_HPP_
+#define MODEL_MODEL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Binary model format (native byte order, little-endian on x86/x64)
+ *
+ *  - Header
+ *  - LayerHeader of each layer (input layer first)
+ *  - Weights and biases of each connected layer, each array starts on a multiple of ALIGNMENT
+ *  - Row offsets (neuralsCount + 1) then columns (linksCount) of each sparse layer (uint32)
+ *
+ * The arrays are stored as they are used by the layers, a mapped file is used in place
+ */
+namespace Model {
+
+	// "ANNM"
+	const uint32_t MAGIC = 0x4D4E4E41;
+
+	// Version written by this code (files of a greater version can not be read)
+	const uint32_t VERSION = 2;
+
+	// Alignment of the arrays (cache line, enough for the widest SIMD load)
+	const uint64_t ALIGNMENT = 64;
+
+	/**
+	 * File header
+	 */
+	struct Header {
+		uint32_t magic;
+		uint32_t version;
+
+		// Size of a value (4: float, 8: double)
+		uint32_t scalarSize;
+		uint32_t layersCount;
+		uint32_t lossFunctionType;
+		uint32_t reserved0;
+		double learningRate;
+
+		// Offset of the first LayerHeader and total size of the file
+		uint64_t layersOffset;
+		uint64_t fileSize;
+		uint64_t reserved[2];
+	};
+
+	/**
+	 * Layer header
+	 */
+	struct LayerHeader {
+		uint32_t neuralType;
+		uint32_t neuralsCount;
+		uint32_t inputsCount;
+		uint32_t aggregationType;
+		uint32_t excitationType;
+
+		// Weights stored as compressed sparse rows (0: dense neuralsCount x inputsCount, since version 2)
+		uint32_t sparse;
+
+		// Offsets of the arrays from the start of the file (0 for the input layer)
+		uint64_t weightsOffset;
+		uint64_t biasesOffset;
+
+		// Offset of the row offsets and the columns of a sparse layer (since version 2)
+		uint64_t indexesOffset;
+	};
+
+	static_assert(sizeof(Header) == 64, "Model header must be 64 bytes");
+	static_assert(sizeof(LayerHeader) == 48, "Model layer header must be 48 bytes");
+
+	/**
+	 * Round an offset up to the alignment of the arrays
+	 * @param offset offset
+	 * @return aligned offset
+	 */
+	inline uint64_t align(uint64_t offset) {
+		return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+	}
+
+}
+
+#endif /* MODEL_MODEL_HPP_ */
@@ -6,13 +6,26 @@
  */
 
 #include <iostream>
-#include <ctime>
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+#include <cmath>
+#include <chrono>
 
 #include "Network.hpp"
+#include "Model/Model.hpp"
 #include "Functions/Loss/Mse/Mse.hpp"
+#include "Functions/Loss/CrossEntropy/CrossEntropy.hpp"
+#include "Functions/Optimizer/Sgd/Sgd.hpp"
+#include "Functions/Optimizer/Momentum/Momentum.hpp"
+#include "Functions/Optimizer/Nesterov/Nesterov.hpp"
+#include "Functions/Optimizer/Adam/Adam.hpp"
 
-Network::Network(double learningRate, LossFunctionType lossFunctionType) {
-	Link::setLearningRate(learningRate);
+template<typename T>
+Network<T>::Network(T learningRate, LossFunctionType lossFunctionType, OptimizerType optimizerType) {
+	// Learning rate of this network
+	this->learningRate = learningRate;
 
 	// Input layer is not set
 	isInputSet = false;
@@ -33,34 +46,104 @@ Network::Network(double learningRate, LossFunctionType lossFunctionType) {
 	lastNeuralLayerIndex = 0;
 	
 	// Loss error used for back propagation
-	loss = 1.0;
+	loss = 1;
 
 	// Instanciation of the loss function
+	setLossFunction(lossFunctionType);
+
+	// Instanciation of the optimizer
+	setOptimizer(optimizerType);
+
+	// Init random (own generator of this network)
+	setSeed(std::random_device()());
+}
+
+template<typename T>
+Network<T>::Network(const TrainingConfig<T>& config) : Network(config.learningRate, config.lossFunctionType, config.optimizerType) {
+	setSeed(config.seed);
+	setThreadPool(config.threadPool);
+}
+
+template<typename T>
+void Network<T>::setSeed(uint64_t seed) {
+	generator.seed(seed);
+}
+
+template<typename T>
+void Network<T>::setLearningRate(T learningRate) {
+	this->learningRate = learningRate;
+}
+
+template<typename T>
+T Network<T>::getLearningRate() const {
+	return learningRate;
+}
+
+template<typename T>
+void Network<T>::setLossFunction(LossFunctionType lossFunctionType) {
+	this->lossFunctionType = lossFunctionType;
 	if (lossFunctionType == LossFunctionType::MSE) {
-		this->lossFunction = std::make_unique<Mse>();
+		this->lossFunction = std::make_unique<Mse<T>>();
+	} else if (lossFunctionType == LossFunctionType::CROSS_ENTROPY) {
+		this->lossFunction = std::make_unique<CrossEntropy<T>>();
 	}
+}
 
-	// Init random
-	srand((int) time(NULL));
+template<typename T>
+void Network<T>::setOptimizer(OptimizerType optimizerType) {
+	switch (optimizerType) {
+	case OptimizerType::SGD:
+		setOptimizer(std::make_unique<Sgd<T>>());
+		break;
+	case OptimizerType::MOMENTUM:
+		setOptimizer(std::make_unique<Momentum<T>>());
+		break;
+	case OptimizerType::NESTEROV:
+		setOptimizer(std::make_unique<Nesterov<T>>());
+		break;
+	case OptimizerType::ADAM:
+		setOptimizer(std::make_unique<Adam<T>>());
+		break;
+	}
 }
 
-void Network::addLayer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT) {
+template<typename T>
+void Network<T>::setOptimizer(std::unique_ptr<Optimizer<T>> optimizer) {
+	if (!optimizer) {
+		throw std::invalid_argument("The optimizer should not be null");
+	}
+	this->optimizer = std::move(optimizer);
+
+	// The layers are already connected: state of their parameters
+	if (isOutputSet) {
+		reserveOptimizer();
+	}
+}
+
+template<typename T>
+void Network<T>::reserveOptimizer() {
+	// Same layout as the parameters in the arena
+	size_t parametersCount = 0;
+	parametersOffsets.assign(layers.size(), 0);
+	for (size_t i = 1; i < layers.size(); ++i) {
+		parametersOffsets.at(i) = parametersCount;
+		parametersCount += layers.at(i).getParametersCount();
+	}
+	optimizer->reserve(parametersCount);
+}
+
+template<typename T>
+void Network<T>::addLayer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection) {
 	// Add a layer
-	std::vector<std::shared_ptr<Neural>> layer = std::vector<std::shared_ptr<Neural>>();
-	for (unsigned int i = 0; i < nbN; ++i) {
-		// New neural define by:
-		// Type, aggregation and excitation
-		auto neural = std::make_shared<Neural>(t, aT, eT);
-		layer.push_back(neural);
-		neural->addBias(-1.0);
-	}
-	neurals.push_back(layer);
+	// Type, aggregation, excitation and links with the previous layer
+	layers.emplace_back(t, nbN, aT, eT, connection);
 	
 	// Update the number of neurals
 	neuralsCount += nbN;
 }
 
-void Network::addInputLayer(unsigned int nbN) {
+template<typename T>
+void Network<T>::addInputLayer(unsigned int nbN) {
 	// Add input layer (no aggregation and no excitation)
 	if (!isInputSet) {
 		addLayer(NeuralType::INPUT_NEURAL, nbN, AggregationType::NO_AGG, ExcitationType::NO_EXC);
@@ -70,10 +153,14 @@ void Network::addInputLayer(unsigned int nbN) {
 	}
 }
 
-void Network::addLayer(unsigned int nbN, AggregationType aT, ExcitationType eT) {
+template<typename T>
+void Network<T>::addLayer(unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection) {
 	// Add hidden layer
+	if (eT == ExcitationType::SOFTMAX) {
+		throw std::invalid_argument("The softmax excitation is only for the output layer");
+	}
 	if (isInputSet && !isOutputSet) {
-		addLayer(NeuralType::HIDDEN_NEURAL, nbN, aT, eT);
+		addLayer(NeuralType::HIDDEN_NEURAL, nbN, aT, eT, connection);
 	} else {
 		if (!isInputSet) {
 			throw std::logic_error("Input layer is not set yet");
@@ -83,10 +170,14 @@ void Network::addLayer(unsigned int nbN, AggregationType aT, ExcitationType eT)
 	}
 }
 
-void Network::addOutputLayer(unsigned int nbN, AggregationType aT, ExcitationType eT) {
+template<typename T>
+void Network<T>::addOutputLayer(unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection) {
 	// Add output layer
+	if (lossFunctionType == LossFunctionType::CROSS_ENTROPY && eT != ExcitationType::SOFTMAX) {
+		throw std::invalid_argument("The cross-entropy loss needs a softmax output layer");
+	}
 	if (isInputSet && !isOutputSet) {
-		addLayer(NeuralType::OUTPUT_NEURAL, nbN, aT, eT);
+		addLayer(NeuralType::OUTPUT_NEURAL, nbN, aT, eT, connection);
 		isOutputSet = true;
 	}
 	else {
@@ -98,90 +189,278 @@ void Network::addOutputLayer(unsigned int nbN, AggregationType aT, ExcitationTyp
 		}
 	}
 
-	// TODO: implements other kind of interconnection
-	fullConnection();
+	connectLayers();
 }
 
-void Network::fullConnection() {
+template<typename T>
+void Network<T>::connectLayers() {
 	// Add counts output and layers
-	outputsCount = (unsigned int)neurals.back().size();
-	lastNeuralLayerIndex = (unsigned int)(neurals.size() - 1);
+	outputsCount = layers.back().getNeuralsCount();
+	lastNeuralLayerIndex = (unsigned int)(layers.size() - 1);
 
-	// Connect all neurals
+	// Links of each layer (l + 1) coming from the layer (l)
 	for (size_t i = 0; i < lastNeuralLayerIndex; ++i) {
-		size_t currentLayerSize = neurals.at(i).size();
-		size_t nextLayerSize = neurals.at(i + 1).size();
-
-		// For each layer (l) to the next one (l + 1)
-		std::vector<std::shared_ptr<Link>> layer = std::vector<std::shared_ptr<Link>>();
-		for (size_t j = 0; j < currentLayerSize; ++j) {
-			for (size_t k = 0; k < nextLayerSize; ++k) {
-				// For each cell in the current layer
-				// Connect output link to the input link of each next neural's layer
-				std::shared_ptr<Neural> previous = getNeuralAt(i, j);
-				std::shared_ptr<Neural> next = getNeuralAt(i + 1, k);
-
-				// Create new link
-				auto link = std::make_shared<Link>(previous, next);
-				link->connect(ConnectDirection::BOTH);
-				layer.push_back(link);
-			}
+		layers.at(i + 1).setLinks(layers.at(i).getNeuralsCount(), generator);
+	}
+
+	// One allocation for all the layers
+	size_t arenaCount = 0;
+	for (size_t i = 0; i < layers.size(); ++i) {
+		if (i > 0) {
+			arenaCount += layers.at(i).getParametersCount();
 		}
+		arenaCount += layers.at(i).getBuffersCount();
+	}
+	arena.reserve(arenaCount);
 
-		// Add bias links (hidden or output neurals)
-		links.push_back(layer);
+	// Connect all layers
+	for (size_t i = 0; i < lastNeuralLayerIndex; ++i) {
+		// Each layer (l + 1) uses the weights of the links coming from the layer (l)
+		layers.at(i + 1).connect(arena, generator);
 
 		// Update the number of links
-		linksCount += (unsigned int)(currentLayerSize * nextLayerSize);
+		linksCount += (unsigned int)layers.at(i + 1).getLinksCount();
 	}
+
+	// Buffers of the neurals after all the weights and biases
+	for (Layer<T>& layer : layers) {
+		layer.allocate(arena);
+	}
+	reserveOptimizer();
+	profiler.resize(layers.size());
 }
 
-std::shared_ptr<Neural>& Network::getNeuralAt(size_t layer, size_t neuralPos) {
-	// Check the validity of parameters
-	if (neurals.size() < layer) {
-		throw std::invalid_argument("Layer is out of bound");
+template<typename T>
+void Network<T>::relinkLayers(std::vector<std::vector<unsigned int>> rowOffsets, std::vector<std::vector<unsigned int>> columns) {
+	// Full copies of the weights and the biases (the arena is rebuilt)
+	std::vector<std::vector<T>> weights(layers.size());
+	std::vector<std::vector<T>> biases(layers.size());
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		layer.copyWeights(weights.at(i));
+		biases.at(i).assign(layer.getBiases(), layer.getBiases() + layer.getNeuralsCount());
+	}
+
+	// New links of each layer
+	for (size_t i = 1; i < layers.size(); ++i) {
+		layers.at(i).setLinks(layers.at(i - 1).getNeuralsCount(), std::move(rowOffsets.at(i)), std::move(columns.at(i)));
 	}
-	if (neurals.at(layer).size() < neuralPos) {
-		throw std::invalid_argument("Neural position is out of bound");
+
+	// One allocation for all the layers
+	size_t arenaCount = 0;
+	for (size_t i = 0; i < layers.size(); ++i) {
+		if (i > 0) {
+			arenaCount += layers.at(i).getParametersCount();
+		}
+		arenaCount += layers.at(i).getBuffersCount();
 	}
+	arena.reserve(arenaCount);
 
-	// Return the neural
-	return neurals.at(layer).at(neuralPos);
+	// Weights of the kept links and biases
+	linksCount = 0;
+	for (size_t i = 1; i < layers.size(); ++i) {
+		Layer<T>& layer = layers.at(i);
+		const std::vector<T>& fullWeights = weights.at(i);
+		size_t inputsCount = layer.getInputsCount();
+		T* layerWeights = arena.allocate(layer.getLinksCount());
+		T* layerBiases = arena.allocate(layer.getNeuralsCount());
+		if (layer.isSparse()) {
+			const std::vector<unsigned int>& layerRowOffsets = layer.getRowOffsets();
+			const std::vector<unsigned int>& layerColumns = layer.getColumns();
+			for (size_t j = 0; j < layer.getNeuralsCount(); ++j) {
+				for (size_t p = layerRowOffsets[j]; p < layerRowOffsets[j + 1]; ++p) {
+					layerWeights[p] = fullWeights[j * inputsCount + layerColumns[p]];
+				}
+			}
+		} else {
+			std::copy(fullWeights.begin(), fullWeights.end(), layerWeights);
+		}
+		std::copy(biases.at(i).begin(), biases.at(i).end(), layerBiases);
+		layer.connect(layerWeights, layerBiases);
+		linksCount += (unsigned int) layer.getLinksCount();
+	}
+
+	// Buffers of the neurals after all the weights and biases
+	for (Layer<T>& layer : layers) {
+		layer.allocate(arena);
+	}
+
+	// The weights are no longer read in the model file, the gradients change of shape
+	mappedFile.reset();
+	batches.clear();
+	reserveOptimizer();
+	profiler.resize(layers.size());
 }
 
-std::shared_ptr<Neural>& Network::getNeuralAtTheLastLayer(size_t neuralPos) {
-	// Return the neural
-	return getNeuralAt(lastNeuralLayerIndex, neuralPos);
+template<typename T>
+void Network<T>::prune(double sparsity) {
+	prune(std::vector<double>(layers.empty() ? 0 : layers.size() - 1, sparsity));
 }
 
-std::shared_ptr<Link>& Network::getLinkAt(size_t layer, size_t linkPos) {
-	// Check the validity of parameters
-	if (links.size() < layer) {
-		throw std::invalid_argument("Layer is out of bound");
+template<typename T>
+void Network<T>::prune(const std::vector<double>& sparsities) {
+	checkEstimate(layers.at(0).getNeuralsCount());
+
+	// Control input parameter: one sparsity by connected layer
+	if (sparsities.size() != layers.size() - 1) {
+		throw std::invalid_argument("There should be one sparsity by connected layer");
 	}
-	if (links.at(layer).size() < linkPos) {
-		throw std::invalid_argument("Link position is out of bound");
+	for (double sparsity : sparsities) {
+		if (!(sparsity >= 0 && sparsity < 1)) {
+			throw std::invalid_argument("The sparsity should be in [0, 1[");
+		}
 	}
 
-	// Return the link
-	return links.at(layer).at(linkPos);
+	std::vector<std::vector<unsigned int>> rowOffsets(layers.size());
+	std::vector<std::vector<unsigned int>> columns(layers.size());
+	bool isPruned = false;
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		size_t neuralsCount = layer.getNeuralsCount();
+		size_t inputsCount = layer.getInputsCount();
+		size_t layerLinksCount = layer.getLinksCount();
+		size_t fullLinksCount = neuralsCount * inputsCount;
+		size_t keptCount = fullLinksCount - (size_t) (sparsities.at(i - 1) * fullLinksCount);
+
+		// Nothing to prune: same links
+		if (keptCount >= layerLinksCount) {
+			rowOffsets.at(i) = layer.getRowOffsets();
+			columns.at(i) = layer.getColumns();
+			continue;
+		}
+		isPruned = true;
+
+		// Links with the largest magnitudes (the first links on equality: same result on each run)
+		const T* weights = layer.getWeights();
+		std::vector<unsigned int> order(layerLinksCount);
+		for (size_t p = 0; p < layerLinksCount; ++p) {
+			order[p] = (unsigned int) p;
+		}
+		std::nth_element(order.begin(), order.begin() + keptCount, order.end(), [weights](unsigned int a, unsigned int b) {
+			T magnitudeA = std::fabs(weights[a]);
+			T magnitudeB = std::fabs(weights[b]);
+			return magnitudeA > magnitudeB || (magnitudeA == magnitudeB && a < b);
+		});
+		std::vector<bool> isKept(layerLinksCount, false);
+		for (size_t p = 0; p < keptCount; ++p) {
+			isKept[order[p]] = true;
+		}
+
+		// Compressed sparse rows of the kept links
+		std::vector<unsigned int>& layerRowOffsets = rowOffsets.at(i);
+		std::vector<unsigned int>& layerColumns = columns.at(i);
+		layerRowOffsets.reserve(neuralsCount + 1);
+		layerColumns.reserve(keptCount);
+		layerRowOffsets.push_back(0);
+		for (size_t j = 0; j < neuralsCount; ++j) {
+			if (layer.isSparse()) {
+				for (size_t p = layer.getRowOffsets()[j]; p < layer.getRowOffsets()[j + 1]; ++p) {
+					if (isKept[p]) {
+						layerColumns.push_back(layer.getColumns()[p]);
+					}
+				}
+			} else {
+				for (size_t k = 0; k < inputsCount; ++k) {
+					if (isKept[j * inputsCount + k]) {
+						layerColumns.push_back((unsigned int) k);
+					}
+				}
+			}
+			layerRowOffsets.push_back((unsigned int) layerColumns.size());
+		}
+	}
+
+	if (isPruned) {
+		relinkLayers(std::move(rowOffsets), std::move(columns));
+	}
 }
 
-int Network::getClassMax() {
+template<typename T>
+void Network<T>::selectKernels(const Matrix<T>& inputValues) {
+	typedef std::chrono::steady_clock Clock;
+	checkEstimate(inputValues.getColsCount());
+	if (inputValues.getRowsCount() == 0) {
+		throw std::invalid_argument("The samples should not be empty");
+	}
+
+	// Shortest time of a forward propagation of a layer (at least 3 runs and 5 ms)
+	size_t rowsCount = inputValues.getRowsCount();
+	Matrix<T> inputs;
+	Matrix<T> outputs;
+	auto time = [&](const Layer<T>& layer, const Matrix<T>& previous) {
+		inputs.resize(rowsCount, layer.getNeuralsCount());
+		outputs.resize(rowsCount, layer.getNeuralsCount());
+		double shortest = 0;
+		double total = 0;
+		for (size_t run = 0; run < 3 || total < 5e-3; ++run) {
+			Clock::time_point start = Clock::now();
+			if (rowsCount == 1) {
+				layer.forwardPropagation(previous.data(), inputs.data(), outputs.data());
+			} else {
+				layer.forwardPropagation(previous, inputs, outputs);
+			}
+			double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+			shortest = (run == 0 ? seconds : std::min(shortest, seconds));
+			total += seconds;
+		}
+		return shortest;
+	};
+
+	std::vector<std::vector<unsigned int>> rowOffsets(layers.size());
+	std::vector<std::vector<unsigned int>> columns(layers.size());
+	bool isChanged = false;
+	Matrix<T> previous(rowsCount, layers.at(0).getNeuralsCount());
+	for (size_t r = 0; r < rowsCount; ++r) {
+		std::copy(inputValues.row(r), inputValues.row(r) + previous.getColsCount(), previous.row(r));
+	}
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		if (layer.isSparse()) {
+			// Same layer with full weights (pruned links at zero)
+			std::vector<T> fullWeights;
+			std::vector<T> fullBiases(layer.getBiases(), layer.getBiases() + layer.getNeuralsCount());
+			layer.copyWeights(fullWeights);
+			Layer<T> full(layer);
+			full.setLinks(layer.getInputsCount(), std::vector<unsigned int>(), std::vector<unsigned int>());
+			full.connect(fullWeights.data(), fullBiases.data());
+
+			if (time(full, previous) < time(layer, previous)) {
+				isChanged = true;
+			} else {
+				rowOffsets.at(i) = layer.getRowOffsets();
+				columns.at(i) = layer.getColumns();
+			}
+		}
+
+		// Outputs of the layer: inputs of the next one
+		inputs.resize(rowsCount, layer.getNeuralsCount());
+		outputs.resize(rowsCount, layer.getNeuralsCount());
+		layer.forwardPropagation(previous, inputs, outputs);
+		std::swap(previous, outputs);
+	}
+
+	if (isChanged) {
+		relinkLayers(std::move(rowOffsets), std::move(columns));
+	}
+}
+
+template<typename T>
+int Network<T>::getClassMax(const T* outputValues) const {
 	int maxClass = 0;
-	double maxClassValue = getNeuralAtTheLastLayer(0)->getOutputValue();
+	T maxClassValue = outputValues[0];
 
 	// For each output neurals, get the highest neural
 	for (unsigned int i = 1; i < outputsCount; ++i) {
-		std::shared_ptr<Neural> n = getNeuralAtTheLastLayer(i);
-		if (n->getOutputValue() > maxClassValue) {
+		if (outputValues[i] > maxClassValue) {
 			maxClass = i;
+			maxClassValue = outputValues[i];
 		}
 	}
 	return maxClass;
 }
 
-void Network::learn(const std::vector<double>& inputValues, const std::vector<double>& expectedValues) {
+template<typename T>
+void Network<T>::learn(const std::vector<T>& inputValues, const std::vector<T>& expectedValues) {
 	// Check if the network is ready
 	if (!isInputSet) {
 		throw std::logic_error("Input layer is not set yet");
@@ -191,40 +470,45 @@ void Network::learn(const std::vector<double>& inputValues, const std::vector<do
 	}
 
 	// Control input parameter: input values
-	if (inputValues.size() < neurals.at(0).size()) {
+	if (inputValues.size() < layers.at(0).getNeuralsCount()) {
 		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
 	}
 	// Control input parameter: expected values
-	if (expectedValues.size() < neurals.at(lastNeuralLayerIndex).size()) {
+	if (expectedValues.size() < outputsCount) {
 		throw std::invalid_argument("The expected values vector should be, at least, equals to output layer");
 	}
 
 	// Set inputs
-	for (size_t i = 0; i < neurals.at(0).size(); ++i) {
-		getNeuralAt(0, i)->setValue(inputValues.at(i));
-	}
+	layers.at(0).setValues(inputValues);
 
-	// Propagate
-	for (size_t i = 0; i < neurals.size(); ++i) {
-		for (size_t j = 0; j < neurals.at(i).size(); ++j) {
-			getNeuralAt(i, j)->forwardPropagation();
+	// Propagate by ranges of neurals (the output layer is only aggregated)
+	for (size_t i = 1; i < layers.size(); ++i) {
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::FORWARD, getBytes(i, ProfilePhase::FORWARD, 1));
+		Layer<T>& layer = layers.at(i);
+		const Layer<T>& previous = layers.at(i - 1);
+		if (i == lastNeuralLayerIndex) {
+			splitRows(layer, [&](size_t first, size_t last) {
+				layer.aggregate(previous, first, last);
+			});
+		} else {
+			splitRows(layer, [&](size_t first, size_t last) {
+				layer.forwardPropagation(previous, first, last);
+			});
 		}
 	}
 
-	// Get output values
-	std::vector<double> outputErrors;
-	for (size_t j = 0; j < neurals.at(lastNeuralLayerIndex).size(); ++j) {
-		outputErrors.push_back(getNeuralAt(lastNeuralLayerIndex, j)->computeDeltaOutput(expectedValues.at(j)));
+	// Get outputs, deltas and loss in one pass (initialisation of the back propagation)
+	{
+		ANN_PROFILE_SCOPE(profiler, lastNeuralLayerIndex, ProfilePhase::OUTPUT_DELTA, getBytes(lastNeuralLayerIndex, ProfilePhase::OUTPUT_DELTA, 1));
+		this->loss = layers.at(lastNeuralLayerIndex).computeDeltaOutput(expectedValues, *lossFunction);
 	}
 
-	// Compare with expected values (initialisation of the back propagation)
-	this->loss = this->lossFunction->compute(outputErrors);
-
 	// Back propagation
 	backPropagation();
 }
 
-int Network::estimate(const std::vector<double>& inputValue) {
+template<typename T>
+void Network<T>::learnBatch(const Matrix<T>& inputValues, const Matrix<T>& expectedValues) {
 	// Check if the network is ready
 	if (!isInputSet) {
 		throw std::logic_error("Input layer is not set yet");
@@ -234,73 +518,710 @@ int Network::estimate(const std::vector<double>& inputValue) {
 	}
 
 	// Control input parameter: input values
-	if (inputValue.size() < neurals.at(0).size()) {
-		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
+	size_t inputsCount = layers.at(0).getNeuralsCount();
+	if (inputValues.getColsCount() < inputsCount) {
+		throw std::invalid_argument("The input values matrix should have, at least, as many columns as the input layer");
+	}
+	// Control input parameter: expected values
+	if (expectedValues.getColsCount() < outputsCount) {
+		throw std::invalid_argument("The expected values matrix should have, at least, as many columns as the output layer");
+	}
+	if (expectedValues.getRowsCount() != inputValues.getRowsCount()) {
+		throw std::invalid_argument("The input and expected values matrix should have the same number of rows");
 	}
 
-	// Set inputs
-	for (size_t i = 0; i < neurals.at(0).size(); ++i) {
-		getNeuralAt(0, i)->setValue(inputValue.at(i));
+	size_t batchSize = inputValues.getRowsCount();
+	if (batchSize == 0) {
+		return;
+	}
+
+	// One shard by thread
+	size_t shardsCount = threadPool ? std::min((size_t)threadPool->getThreadsCount(), batchSize) : 1;
+	if (batches.size() < shardsCount) {
+		batches.resize(shardsCount);
 	}
+	std::vector<T> losses(shardsCount);
+	auto shard = [&](size_t s) {
+		size_t first = s * batchSize / shardsCount;
+		size_t last = (s + 1) * batchSize / shardsCount;
+		losses.at(s) = computeGradients(inputValues, expectedValues, first, last - first, batches.at(s)) * (last - first);
+	};
+	if (shardsCount == 1) {
+		shard(0);
+	} else {
+		threadPool->run(shardsCount, shard);
+
+		// Sum the gradients in batches[0] (pairwise tree, fixed order)
+		for (size_t step = 1; step < shardsCount; step *= 2) {
+			size_t pairsCount = (shardsCount - step + 2 * step - 1) / (2 * step);
+			threadPool->run(pairsCount, [&](size_t p) {
+				size_t i = p * 2 * step;
+				batches.at(i).accumulate(batches.at(i + step));
+			});
+		}
+	}
+
+	// Mean of the loss of each sample
+	T sumLoss = 0;
+	for (size_t s = 0; s < shardsCount; ++s) {
+		sumLoss += losses.at(s);
+	}
+	this->loss = sumLoss / batchSize;
+
+	// Update the weights once with the mean gradient
+	Batch<T>& batch = batches.at(0);
+	optimizer->step();
+	for (size_t i = 1; i < layers.size(); ++i) {
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::UPDATE, getBytes(i, ProfilePhase::UPDATE, batchSize));
+		layers.at(i).applyGradients(batch.getWeightsGradients(i), batch.getBiasesGradients(i), (T) 1 / batchSize, *optimizer, parametersOffsets.at(i), learningRate);
+	}
+}
+
+template<typename T>
+void Network<T>::splitRows(size_t rowsCount, size_t rowCost, const std::function<void(size_t, size_t)>& rows) const {
+	// Ranges of whole blocks of the kernels, large enough to pay for the scheduling, a few by
+	// thread to balance the load (stolen by the threads that end first)
+	const size_t BLOCK_ROWS = 64;
+	const size_t MIN_RANGE_COST = 1 << 15;
+	const size_t RANGES_BY_THREAD = 4;
+	size_t rangeRows = (MIN_RANGE_COST / std::max(rowCost, (size_t) 1) + BLOCK_ROWS - 1) / BLOCK_ROWS * BLOCK_ROWS;
+	rangeRows = std::max(rangeRows, BLOCK_ROWS);
+	if (threadPool) {
+		size_t maxRangesCount = threadPool->getThreadsCount() * RANGES_BY_THREAD;
+		rangeRows = std::max(rangeRows, ((rowsCount + maxRangesCount - 1) / maxRangesCount + BLOCK_ROWS - 1) / BLOCK_ROWS * BLOCK_ROWS);
+	}
+	size_t rangesCount = (rowsCount + rangeRows - 1) / rangeRows;
+	if (!threadPool || rangesCount <= 1) {
+		rows(0, rowsCount);
+		return;
+	}
+	// On the calling thread when the pool is busy (concurrent estimations are not serialized)
+	threadPool->tryRun(rangesCount, [&](size_t r) {
+		rows(r * rangeRows, std::min(rowsCount, (r + 1) * rangeRows));
+	});
+}
+
+template<typename T>
+void Network<T>::splitRows(const Layer<T>& layer, const std::function<void(size_t, size_t)>& rows) const {
+	// Cost of a neural: its mean number of links (none without neurals)
+	size_t neuralsCount = layer.getNeuralsCount();
+	splitRows(neuralsCount, neuralsCount ? layer.getLinksCount() / neuralsCount : 0, rows);
+}
+
+template<typename T>
+T Network<T>::computeGradients(const Matrix<T>& inputValues, const Matrix<T>& expectedValues, size_t first, size_t count, Batch<T>& batch) {
+	batch.resize(layers, count);
+
+	// Set inputs and expected values of the shard
+	size_t inputsCount = layers.at(0).getNeuralsCount();
+	Matrix<T>& inputs = batch.getOutputValues(0);
+	Matrix<T>& expected = batch.getExpectedValues();
+	for (size_t r = 0; r < count; ++r) {
+		std::copy(inputValues.row(first + r), inputValues.row(first + r) + inputsCount, inputs.row(r));
+		std::copy(expectedValues.row(first + r), expectedValues.row(first + r) + outputsCount, expected.row(r));
+	}
+
+	// Propagate (the output layer is only aggregated)
+	for (size_t i = 1; i < layers.size(); ++i) {
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::FORWARD, getBytes(i, ProfilePhase::FORWARD, count));
+		if (i == lastNeuralLayerIndex) {
+			layers.at(i).aggregate(batch.getOutputValues(i - 1), batch.getInputValues(i));
+		} else {
+			layers.at(i).forwardPropagation(batch.getOutputValues(i - 1), batch.getInputValues(i), batch.getOutputValues(i), batch.getDerivatives(i));
+		}
+	}
+
+	// Get outputs, deltas and loss (mean of the loss of each sample) in one pass
+	T loss;
+	{
+		ANN_PROFILE_SCOPE(profiler, lastNeuralLayerIndex, ProfilePhase::OUTPUT_DELTA, getBytes(lastNeuralLayerIndex, ProfilePhase::OUTPUT_DELTA, count));
+		loss = layers.at(lastNeuralLayerIndex).computeDeltaOutput(expected, *lossFunction, batch.getInputValues(lastNeuralLayerIndex), batch.getOutputValues(lastNeuralLayerIndex), batch.getDeltas(lastNeuralLayerIndex));
+	}
+
+	// Back propagation: deltas and gradients with the current weights
+	for (size_t i = lastNeuralLayerIndex; i >= 1; --i) {
+		if (i > 1) {
+			ANN_PROFILE_SCOPE(profiler, i - 1, ProfilePhase::DELTA, getBytes(i - 1, ProfilePhase::DELTA, count));
+			layers.at(i - 1).computeDeltas(layers.at(i), batch.getDeltas(i), batch.getDerivatives(i - 1), batch.getDeltas(i - 1));
+		}
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::GRADIENT, getBytes(i, ProfilePhase::GRADIENT, count));
+		layers.at(i).computeGradients(batch.getOutputValues(i - 1), batch.getDeltas(i), batch.getWeightsGradients(i), batch.getBiasesGradients(i));
+	}
+
+	return loss;
+}
+
+template<typename T>
+void Network<T>::setThreadsCount(unsigned int threadsCount) {
+	if (threadsCount == 1) {
+		threadPool = nullptr;
+	} else {
+		threadPool = std::make_shared<ThreadPool>(threadsCount);
+	}
+}
+
+template<typename T>
+void Network<T>::setThreadPool(std::shared_ptr<ThreadPool> threadPool) {
+	this->threadPool = threadPool;
+}
+
+template<typename T>
+void Network<T>::checkEstimate(size_t inputValuesCount) const {
+	// Check if the network is ready
+	if (!isInputSet) {
+		throw std::logic_error("Input layer is not set yet");
+	}
+	if (!isOutputSet) {
+		throw std::logic_error("Output layer is not set yet");
+	}
+
+	// Control input parameter: input values
+	if (inputValuesCount < layers.at(0).getNeuralsCount()) {
+		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
+	}
+}
 
-	// Propagate
-	for (size_t i = 0; i < neurals.size(); ++i) {
-		for (size_t j = 0; j < neurals.at(i).size(); ++j) {
-			getNeuralAt(i, j)->forwardPropagation();
+template<typename T>
+const T* Network<T>::propagate(const T* inputValues, Scratch<T>& scratch) const {
+	// Propagate by ranges of neurals (the input layer reads directly the input values)
+	const T* previous = inputValues;
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers[i];
+		size_t neuralsCount = layer.getNeuralsCount();
+		Matrix<T>& inputs = scratch.getInputValues();
+		Matrix<T>& outputs = scratch.getOutputValues(i);
+		inputs.resize(1, neuralsCount);
+		outputs.resize(1, neuralsCount);
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::ESTIMATE, getBytes(i, ProfilePhase::ESTIMATE, 1));
+		if (layer.getExcitationType() == ExcitationType::SOFTMAX) {
+			layer.forwardPropagation(previous, inputs.data(), outputs.data());
+		} else {
+			splitRows(layer, [&](size_t first, size_t last) {
+				layer.forwardPropagation(previous, inputs.data(), outputs.data(), first, last);
+			});
 		}
+		previous = outputs.data();
 	}
+	return previous;
+}
+
+template<typename T>
+const Matrix<T>& Network<T>::propagate(const Matrix<T>& inputValues, Scratch<T>& scratch) const {
+	// Propagate (the input layer reads directly the input values)
+	const Matrix<T>* previous = &inputValues;
+	for (size_t i = 1; i < layers.size(); ++i) {
+		size_t neuralsCount = layers[i].getNeuralsCount();
+		Matrix<T>& inputs = scratch.getInputValues();
+		Matrix<T>& outputs = scratch.getOutputValues(i);
+		inputs.resize(inputValues.getRowsCount(), neuralsCount);
+		outputs.resize(inputValues.getRowsCount(), neuralsCount);
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::ESTIMATE, getBytes(i, ProfilePhase::ESTIMATE, inputValues.getRowsCount()));
+		layers[i].forwardPropagation(*previous, inputs, outputs);
+		previous = &outputs;
+	}
+	return *previous;
+}
+
+template<typename T>
+int Network<T>::estimate(const std::vector<T>& inputValue) const {
+	checkEstimate(inputValue.size());
+
+	// Buffers of this thread
+	static thread_local Scratch<T> scratch;
 
 	// Return max class
-	return getClassMax();
+	return getClassMax(propagate(inputValue.data(), scratch));
+}
+
+template<typename T>
+int Network<T>::estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues, Scratch<T>& scratch) const {
+	checkEstimate(inputValues.size());
+
+	// Copy the output values and return max class
+	const T* outputs = propagate(inputValues.data(), scratch);
+	outputValues.assign(outputs, outputs + outputsCount);
+	return getClassMax(outputs);
+}
+
+template<typename T>
+void Network<T>::estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues) const {
+	std::vector<unsigned int> topClasses;
+	Matrix<T> topScores;
+	estimateBatch(inputValues, outputValues, 0, topClasses, topScores);
+}
+
+template<typename T>
+void Network<T>::estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues, size_t k, std::vector<unsigned int>& topClasses, Matrix<T>& topScores) const {
+	// Check once for the whole batch
+	checkEstimate(inputValues.getColsCount());
+
+	size_t rowsCount = inputValues.getRowsCount();
+	size_t inputsCount = layers.at(0).getNeuralsCount();
+	k = std::min(k, (size_t)outputsCount);
+	outputValues.resize(rowsCount, outputsCount);
+	topClasses.resize(rowsCount * k);
+	topScores.resize(rowsCount, k);
+
+	// Buffers of this thread
+	static thread_local Scratch<T> scratch;
+	static thread_local Matrix<T> chunk;
+
+	// Chunks of rows: the values of a chunk stay in cache from a layer to the next
+	const size_t CHUNK_ROWS = 256;
+	for (size_t first = 0; first < rowsCount; first += CHUNK_ROWS) {
+		size_t count = std::min(CHUNK_ROWS, rowsCount - first);
+		chunk.resize(count, inputsCount);
+		for (size_t r = 0; r < count; ++r) {
+			std::copy(inputValues.row(first + r), inputValues.row(first + r) + inputsCount, chunk.row(r));
+		}
+
+		const Matrix<T>& outputs = propagate(chunk, scratch);
+		std::copy(outputs.data(), outputs.data() + count * outputsCount, outputValues.row(first));
+
+		// K best classes of each row (insertion in a sorted list of k classes)
+		for (size_t r = 0; r < count && k > 0; ++r) {
+			const T* values = outputs.row(r);
+			unsigned int* classes = topClasses.data() + (first + r) * k;
+			T* scores = topScores.row(first + r);
+			size_t found = 0;
+			for (unsigned int c = 0; c < outputsCount; ++c) {
+				if (found == k && values[c] <= scores[k - 1]) {
+					continue;
+				}
+				size_t pos = (found < k) ? found++ : k - 1;
+				while (pos > 0 && scores[pos - 1] < values[c]) {
+					scores[pos] = scores[pos - 1];
+					classes[pos] = classes[pos - 1];
+					--pos;
+				}
+				scores[pos] = values[c];
+				classes[pos] = c;
+			}
+		}
+	}
+}
+
+template<typename T>
+T Network<T>::evaluate(const Matrix<T>& inputValues, const Matrix<T>& expectedValues, Matrix<T>& outputValues) const {
+	// Check once for the whole batch
+	checkEstimate(inputValues.getColsCount());
+
+	// Control input parameter: expected values
+	size_t rowsCount = inputValues.getRowsCount();
+	if (rowsCount == 0) {
+		throw std::invalid_argument("The samples should not be empty");
+	}
+	if (expectedValues.getColsCount() < outputsCount) {
+		throw std::invalid_argument("The expected values matrix should have, at least, as many columns as the output layer");
+	}
+	if (expectedValues.getRowsCount() != rowsCount) {
+		throw std::invalid_argument("The input and expected values matrix should have the same number of rows");
+	}
+
+	size_t inputsCount = layers.at(0).getNeuralsCount();
+	outputValues.resize(rowsCount, outputsCount);
+
+	// Buffers of this thread
+	static thread_local Scratch<T> scratch;
+	static thread_local Matrix<T> chunk;
+	static thread_local Matrix<T> expectedChunk;
+	static thread_local Matrix<T> deltas;
+
+	// Chunks of rows: the values of a chunk stay in cache from a layer to the next
+	const size_t CHUNK_ROWS = 256;
+	T sumLoss = 0;
+	for (size_t first = 0; first < rowsCount; first += CHUNK_ROWS) {
+		size_t count = std::min(CHUNK_ROWS, rowsCount - first);
+		chunk.resize(count, inputsCount);
+		expectedChunk.resize(count, outputsCount);
+		for (size_t r = 0; r < count; ++r) {
+			std::copy(inputValues.row(first + r), inputValues.row(first + r) + inputsCount, chunk.row(r));
+			std::copy(expectedValues.row(first + r), expectedValues.row(first + r) + outputsCount, expectedChunk.row(r));
+		}
+
+		// Propagate to the last hidden layer
+		const Matrix<T>* previous = &chunk;
+		for (size_t i = 1; i < lastNeuralLayerIndex; ++i) {
+			Matrix<T>& inputs = scratch.getInputValues();
+			Matrix<T>& outputs = scratch.getOutputValues(i);
+			inputs.resize(count, layers[i].getNeuralsCount());
+			outputs.resize(count, layers[i].getNeuralsCount());
+			ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::ESTIMATE, getBytes(i, ProfilePhase::ESTIMATE, count));
+			layers[i].forwardPropagation(*previous, inputs, outputs);
+			previous = &outputs;
+		}
+
+		// Output layer: outputs and loss in one pass (the deltas are not used)
+		const Layer<T>& output = layers[lastNeuralLayerIndex];
+		Matrix<T>& inputs = scratch.getInputValues();
+		Matrix<T>& outputs = scratch.getOutputValues(lastNeuralLayerIndex);
+		inputs.resize(count, outputsCount);
+		outputs.resize(count, outputsCount);
+		deltas.resize(count, outputsCount);
+		{
+			ANN_PROFILE_SCOPE(profiler, lastNeuralLayerIndex, ProfilePhase::ESTIMATE, getBytes(lastNeuralLayerIndex, ProfilePhase::ESTIMATE, count));
+			output.aggregate(*previous, inputs);
+			sumLoss += output.computeDeltaOutput(expectedChunk, *lossFunction, inputs, outputs, deltas) * count;
+		}
+		std::copy(outputs.data(), outputs.data() + count * outputsCount, outputValues.row(first));
+	}
+	return sumLoss / rowsCount;
+}
+
+template<typename T>
+void Network<T>::save(const std::string& path) const {
+	save(path, nullptr);
 }
 
-double Network::getLoss() {
+template<typename T>
+void Network<T>::save(const std::string& path, const T* parameters) const {
+	// Check if the network is ready
+	if (!isInputSet) {
+		throw std::logic_error("Input layer is not set yet");
+	}
+	if (!isOutputSet) {
+		throw std::logic_error("Output layer is not set yet");
+	}
+
+	// Topology and offsets of the arrays
+	Model::Header header = Model::Header();
+	header.magic = Model::MAGIC;
+	header.version = Model::VERSION;
+	header.scalarSize = sizeof(T);
+	header.layersCount = (uint32_t) layers.size();
+	header.lossFunctionType = (uint32_t) lossFunctionType;
+	header.learningRate = (double) learningRate;
+	header.layersOffset = sizeof(Model::Header);
+
+	std::vector<Model::LayerHeader> layerHeaders(layers.size(), Model::LayerHeader());
+	uint64_t offset = Model::align(header.layersOffset + layers.size() * sizeof(Model::LayerHeader));
+	for (size_t i = 0; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		Model::LayerHeader& layerHeader = layerHeaders.at(i);
+		layerHeader.neuralType = (uint32_t) layer.getType();
+		layerHeader.neuralsCount = layer.getNeuralsCount();
+		layerHeader.inputsCount = layer.getInputsCount();
+		layerHeader.aggregationType = (uint32_t) layer.getAggregationType();
+		layerHeader.excitationType = (uint32_t) layer.getExcitationType();
+		layerHeader.sparse = layer.isSparse() ? 1 : 0;
+		if (i > 0) {
+			layerHeader.weightsOffset = offset;
+			offset = Model::align(offset + layer.getLinksCount() * sizeof(T));
+			layerHeader.biasesOffset = offset;
+			offset = Model::align(offset + layer.getNeuralsCount() * sizeof(T));
+		}
+		if (layer.isSparse()) {
+			layerHeader.indexesOffset = offset;
+			offset = Model::align(offset + (layer.getRowOffsets().size() + layer.getColumns().size()) * sizeof(uint32_t));
+		}
+	}
+	header.fileSize = offset;
+
+	// Write the headers and the arrays (padded with zeros)
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Can not open " + path);
+	}
+	const char padding[Model::ALIGNMENT] = {};
+	auto pad = [&](uint64_t to) {
+		file.write(padding, (std::streamsize) (to - (uint64_t) file.tellp()));
+	};
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(layerHeaders.data()), layerHeaders.size() * sizeof(Model::LayerHeader));
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		const T* weights = parameters ? parameters + parametersOffsets.at(i) : layer.getWeights();
+		const T* biases = parameters ? weights + Arena<T>::align(layer.getLinksCount()) : layer.getBiases();
+		pad(layerHeaders.at(i).weightsOffset);
+		file.write(reinterpret_cast<const char*>(weights), layer.getLinksCount() * sizeof(T));
+		pad(layerHeaders.at(i).biasesOffset);
+		file.write(reinterpret_cast<const char*>(biases), layer.getNeuralsCount() * sizeof(T));
+		if (layer.isSparse()) {
+			static_assert(sizeof(unsigned int) == sizeof(uint32_t), "Indexes are stored as uint32");
+			pad(layerHeaders.at(i).indexesOffset);
+			file.write(reinterpret_cast<const char*>(layer.getRowOffsets().data()), layer.getRowOffsets().size() * sizeof(uint32_t));
+			file.write(reinterpret_cast<const char*>(layer.getColumns().data()), layer.getColumns().size() * sizeof(uint32_t));
+		}
+	}
+	pad(header.fileSize);
+	file.close();
+	if (!file) {
+		throw std::runtime_error("Can not write " + path);
+	}
+}
+
+template<typename T>
+size_t Network<T>::getParametersCount() const {
+	if (!isOutputSet) {
+		return 0;
+	}
+	return parametersOffsets.back() + layers.back().getParametersCount();
+}
+
+template<typename T>
+void Network<T>::copyParameters(T* parameters) const {
+	// Check if the network is ready
+	if (!isInputSet) {
+		throw std::logic_error("Input layer is not set yet");
+	}
+	if (!isOutputSet) {
+		throw std::logic_error("Output layer is not set yet");
+	}
+
+	// Weights and biases owned: they are the start of the arena, in the same layout
+	if (!mappedFile) {
+		std::memcpy(parameters, arena.data(), getParametersCount() * sizeof(T));
+		return;
+	}
+
+	// Weights and biases mapped from a model file: layer by layer (the padding is left as it is)
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Layer<T>& layer = layers.at(i);
+		T* weights = parameters + parametersOffsets.at(i);
+		std::memcpy(weights, layer.getWeights(), layer.getLinksCount() * sizeof(T));
+		std::memcpy(weights + Arena<T>::align(layer.getLinksCount()), layer.getBiases(), layer.getNeuralsCount() * sizeof(T));
+	}
+}
+
+template<typename T>
+void Network<T>::setParameters(const T* parameters) {
+	// Check if the network is ready
+	if (!isInputSet) {
+		throw std::logic_error("Input layer is not set yet");
+	}
+	if (!isOutputSet) {
+		throw std::logic_error("Output layer is not set yet");
+	}
+
+	// Weights and biases owned: they are the start of the arena, in the same layout
+	if (!mappedFile) {
+		std::memcpy(arena.data(), parameters, getParametersCount() * sizeof(T));
+		return;
+	}
+
+	// Weights and biases mapped from a model file: layer by layer
+	for (size_t i = 1; i < layers.size(); ++i) {
+		Layer<T>& layer = layers.at(i);
+		const T* weights = parameters + parametersOffsets.at(i);
+		layer.setParameters(weights, weights + Arena<T>::align(layer.getLinksCount()));
+	}
+}
+
+template<typename T>
+void Network<T>::load(const std::string& path) {
+	if (isInputSet) {
+		throw std::logic_error("The network is already built");
+	}
+
+	std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>(path);
+	const unsigned char* bytes = file->data();
+	uint64_t size = file->getSize();
+	auto check = [&](bool condition, const char* reason) {
+		if (!condition) {
+			throw std::runtime_error("Invalid model " + path + ": " + reason);
+		}
+	};
+
+	// Check the header
+	Model::Header header;
+	check(size >= sizeof(header), "truncated header");
+	std::memcpy(&header, bytes, sizeof(header));
+	check(header.magic == Model::MAGIC, "not a model file");
+	check(header.version <= Model::VERSION, "unsupported version");
+	check(header.scalarSize == sizeof(T), "scalar type does not match the network");
+	check(header.fileSize == size, "truncated file");
+	check(header.layersCount >= 2, "not enough layers");
+	check(header.lossFunctionType <= (uint32_t) LossFunctionType::CROSS_ENTROPY, "unknown loss function");
+	check(header.layersOffset <= size && header.layersCount <= (size - header.layersOffset) / sizeof(Model::LayerHeader), "truncated layers");
+
+	// Check the layers
+	std::vector<Model::LayerHeader> layerHeaders(header.layersCount);
+	std::memcpy(layerHeaders.data(), bytes + header.layersOffset, layerHeaders.size() * sizeof(Model::LayerHeader));
+	for (size_t i = 0; i < layerHeaders.size(); ++i) {
+		const Model::LayerHeader& layerHeader = layerHeaders.at(i);
+		NeuralType expectedType = (i == 0) ? NeuralType::INPUT_NEURAL : (i + 1 == layerHeaders.size()) ? NeuralType::OUTPUT_NEURAL : NeuralType::HIDDEN_NEURAL;
+		check(layerHeader.neuralType == (uint32_t) expectedType, "unexpected layer type");
+		check(layerHeader.aggregationType <= (uint32_t) AggregationType::SUM, "unknown aggregation");
+		check(layerHeader.excitationType <= (uint32_t) ExcitationType::SOFTMAX, "unknown excitation");
+		check(layerHeader.excitationType != (uint32_t) ExcitationType::SOFTMAX || expectedType == NeuralType::OUTPUT_NEURAL, "softmax excitation on a hidden layer");
+		check(header.lossFunctionType != (uint32_t) LossFunctionType::CROSS_ENTROPY || expectedType != NeuralType::OUTPUT_NEURAL || layerHeader.excitationType == (uint32_t) ExcitationType::SOFTMAX, "cross-entropy loss without a softmax output layer");
+		check(layerHeader.sparse <= 1 && (i > 0 || layerHeader.sparse == 0), "unknown links storage");
+		if (i > 0) {
+			uint64_t linksCount = (uint64_t) layerHeader.neuralsCount * layerHeader.inputsCount;
+			if (layerHeader.sparse) {
+				// Number of links at the end of the row offsets
+				uint64_t rowsCount = (uint64_t) layerHeader.neuralsCount + 1;
+				check(layerHeader.indexesOffset % Model::ALIGNMENT == 0, "unaligned arrays");
+				check(layerHeader.indexesOffset <= size && rowsCount <= (size - layerHeader.indexesOffset) / sizeof(uint32_t), "truncated row offsets");
+				uint32_t sparseLinksCount;
+				std::memcpy(&sparseLinksCount, bytes + layerHeader.indexesOffset + layerHeader.neuralsCount * sizeof(uint32_t), sizeof(uint32_t));
+				linksCount = sparseLinksCount;
+				check(rowsCount + linksCount <= (size - layerHeader.indexesOffset) / sizeof(uint32_t), "truncated columns");
+			}
+			check(layerHeader.inputsCount == layerHeaders.at(i - 1).neuralsCount, "layers are not connected");
+			check(layerHeader.weightsOffset % Model::ALIGNMENT == 0 && layerHeader.biasesOffset % Model::ALIGNMENT == 0, "unaligned arrays");
+			check(layerHeader.weightsOffset <= size && linksCount <= (size - layerHeader.weightsOffset) / sizeof(T), "truncated weights");
+			check(layerHeader.biasesOffset <= size && layerHeader.neuralsCount <= (size - layerHeader.biasesOffset) / sizeof(T), "truncated biases");
+		}
+	}
+
+	// Build the layers
+	learningRate = (T) header.learningRate;
+	setLossFunction((LossFunctionType) header.lossFunctionType);
+	for (const Model::LayerHeader& layerHeader : layerHeaders) {
+		addLayer((NeuralType) layerHeader.neuralType, layerHeader.neuralsCount, (AggregationType) layerHeader.aggregationType, (ExcitationType) layerHeader.excitationType);
+	}
+	isInputSet = true;
+	isOutputSet = true;
+	outputsCount = layers.back().getNeuralsCount();
+	lastNeuralLayerIndex = (unsigned int) (layers.size() - 1);
+
+	// The weights are used in place (copy-on-write pages of the mapping)
+	unsigned char* base = file->data();
+	for (size_t i = 1; i < layers.size(); ++i) {
+		const Model::LayerHeader& layerHeader = layerHeaders.at(i);
+		if (layerHeader.sparse) {
+			// The indexes are copied (and checked)
+			std::vector<unsigned int> rowOffsets(layerHeader.neuralsCount + 1);
+			std::memcpy(rowOffsets.data(), bytes + layerHeader.indexesOffset, rowOffsets.size() * sizeof(uint32_t));
+			std::vector<unsigned int> columns(rowOffsets.back());
+			std::memcpy(columns.data(), bytes + layerHeader.indexesOffset + rowOffsets.size() * sizeof(uint32_t), columns.size() * sizeof(uint32_t));
+			try {
+				layers.at(i).setLinks(layerHeader.inputsCount, std::move(rowOffsets), std::move(columns));
+			} catch (const std::invalid_argument& e) {
+				throw std::runtime_error("Invalid model " + path + ": " + e.what());
+			}
+		} else {
+			layers.at(i).setLinks(layerHeader.inputsCount, generator);
+		}
+		layers.at(i).connect(reinterpret_cast<T*>(base + layerHeader.weightsOffset), reinterpret_cast<T*>(base + layerHeader.biasesOffset));
+		linksCount += (unsigned int) layers.at(i).getLinksCount();
+	}
+
+	// Only the buffers of the neurals are taken from the arena
+	size_t arenaCount = 0;
+	for (const Layer<T>& layer : layers) {
+		arenaCount += layer.getBuffersCount();
+	}
+	arena.reserve(arenaCount);
+	for (Layer<T>& layer : layers) {
+		layer.allocate(arena);
+	}
+	reserveOptimizer();
+	profiler.resize(layers.size());
+	mappedFile = file;
+}
+
+template<typename T>
+size_t Network<T>::getLayersCount() const {
+	return layers.size();
+}
+
+template<typename T>
+const Layer<T>& Network<T>::getLayer(size_t i) const {
+	return layers.at(i);
+}
+
+template<typename T>
+uint64_t Network<T>::getBytes(size_t layer, ProfilePhase phase, size_t rowsCount) const {
+	const Layer<T>& l = layers.at(layer);
+	uint64_t linksCount = l.getLinksCount();
+	uint64_t neuralsCount = l.getNeuralsCount();
+	uint64_t inputsCount = l.getInputsCount();
+	uint64_t valuesCount = 0;
+	switch (phase) {
+	case ProfilePhase::ESTIMATE:
+		// Weights, biases, previous outputs, inputs and outputs
+		valuesCount = linksCount + neuralsCount + rowsCount * (inputsCount + 2 * neuralsCount);
+		break;
+	case ProfilePhase::FORWARD:
+		// Weights, biases, previous outputs, inputs, outputs and derivatives
+		valuesCount = linksCount + neuralsCount + rowsCount * (inputsCount + 3 * neuralsCount);
+		break;
+	case ProfilePhase::OUTPUT_DELTA:
+		// Biases, inputs (read and written), expected values, outputs and deltas (the loss in the same pass)
+		valuesCount = neuralsCount + 5 * rowsCount * neuralsCount;
+		break;
+	case ProfilePhase::DELTA: {
+		// Weights and deltas of the next layer, derivatives and deltas
+		const Layer<T>& next = layers.at(layer + 1);
+		valuesCount = next.getLinksCount() + rowsCount * (next.getNeuralsCount() + 2 * neuralsCount);
+		break;
+	}
+	case ProfilePhase::GRADIENT:
+		// Previous outputs, deltas and gradients (read and written)
+		valuesCount = rowsCount * (inputsCount + neuralsCount) + 2 * (linksCount + neuralsCount);
+		break;
+	case ProfilePhase::UPDATE:
+		// Gradients, weights and biases (read and written) and the state of the optimizer (read and written)
+		valuesCount = (3 + 2 * optimizer->getStatesCount()) * (linksCount + neuralsCount) + inputsCount;
+		break;
+	}
+	return valuesCount * sizeof(T);
+}
+
+template<typename T>
+const Profiler& Network<T>::getProfiler() const {
+	return profiler;
+}
+
+template<typename T>
+void Network<T>::resetProfiler() {
+	profiler.reset();
+}
+
+template<typename T>
+T Network<T>::getLoss() {
 	return loss;
 }
 
-void Network::backPropagation() {
-	// Back propagation (hidden/output layers only: not input layer)
+template<typename T>
+void Network<T>::backPropagation() {
+	// Back propagation (hidden/output layers only: not input layer), by ranges of neurals
+	optimizer->step();
 	for (size_t i = lastNeuralLayerIndex; i >= 1; --i) {
-		// Every neurals of the layer
-		for (size_t j = 0; j < neurals.at(i).size(); ++j) {
-			getNeuralAt(i, j)->backwardPropagation();
+		Layer<T>& layer = layers.at(i);
+		Layer<T>& previous = layers.at(i - 1);
+
+		// Deltas of the previous layer are computed before the update of the weights (by columns
+		// of the weights, the columns of sparse weights as a whole)
+		if (i > 1) {
+			ANN_PROFILE_SCOPE(profiler, i - 1, ProfilePhase::DELTA, getBytes(i - 1, ProfilePhase::DELTA, 1));
+			if (layer.isSparse()) {
+				previous.computeDeltas(layer);
+			} else {
+				splitRows(previous.getNeuralsCount(), layer.getNeuralsCount(), [&](size_t first, size_t last) {
+					previous.computeDeltas(layer, first, last);
+				});
+			}
 		}
+		ANN_PROFILE_SCOPE(profiler, i, ProfilePhase::UPDATE, getBytes(i, ProfilePhase::UPDATE, 1));
+		size_t offset = parametersOffsets.at(i);
+		splitRows(layer, [&](size_t first, size_t last) {
+			layer.computeWeights(previous, *optimizer, offset, learningRate, first, last);
+		});
 	}
 }
 
-void Network::print(bool full) {
+template<typename T>
+void Network<T>::print(bool full) {
 	if (full) {
 		// Full network
 
-		for (size_t i = 0; i < links.size(); ++i) {
+		for (size_t i = 0; i < lastNeuralLayerIndex; ++i) {
 			if (isInputSet && i == 0) {
-				std::cout << "INPUT LAYER:\t";
-				for (size_t j = 0; j < neurals.at(0).size(); ++j) {
-					std::cout << getNeuralAt(0, j)->toString() << " ";
-				}
-				std::cout << std::endl;
+				std::cout << "INPUT LAYER:\t" << layers.at(0).toString() << std::endl;
 			}
 			else {
-				std::cout << "NEURALS LAYER:\t";
-				for (size_t j = 0; j < neurals.at(i).size(); ++j) {
-					std::cout << getNeuralAt(i, j)->toString() << " ";
-				}
-				std::cout << std::endl;
+				std::cout << "NEURALS LAYER:\t" << layers.at(i).toString() << std::endl;
 			}
 
-			std::cout << std::endl << "LINKS LAYER:\t";
-			for (size_t j = 0; j < links.at(i).size(); ++j) {
-				std::cout << getLinkAt(i, j)->toString() << " ";
-			}
+			std::cout << std::endl << "LINKS LAYER:\t" << layers.at(i + 1).linksToString();
 			std::cout << std::endl << std::endl;
 		}
 
 		if (isOutputSet) {
-			std::cout << "OUTPUT LAYER:\t";
-			for (size_t j = 0; j < neurals.at(lastNeuralLayerIndex).size(); ++j) {
-				std::cout << getNeuralAt(lastNeuralLayerIndex, j)->toString() << " ";
-			}
-			std::cout << std::endl;
+			std::cout << "OUTPUT LAYER:\t" << layers.at(lastNeuralLayerIndex).toString() << std::endl;
 		}
 
 		std::cout << std::endl;
@@ -311,18 +1232,13 @@ void Network::print(bool full) {
 		// Input and output only
 
 		if (isInputSet) {
-			std::cout << "INPUT LAYER:\t";
-			for (size_t j = 0; j < neurals.at(0).size(); ++j) {
-				std::cout << getNeuralAt(0, j)->toString() << " ";
-			}
-			std::cout << std::endl;
+			std::cout << "INPUT LAYER:\t" << layers.at(0).toString() << std::endl;
 		}
 		if (isOutputSet) {
-			std::cout << "OUTPUT LAYER:\t";
-			for (size_t j = 0; j < neurals.at(lastNeuralLayerIndex).size(); ++j) {
-				std::cout << getNeuralAt(lastNeuralLayerIndex, j)->toString() << " ";
-			}
-			std::cout << std::endl;
+			std::cout << "OUTPUT LAYER:\t" << layers.at(lastNeuralLayerIndex).toString() << std::endl;
 		}
 	}
 }
+
+template class Network<float>;
+template class Network<double>;
@@ -11,15 +11,32 @@
 #define NETWORK_NETWORK_HPP_
 
 #include <vector>
+#include <string>
+#include <memory>
+#include <random>
+#include <functional>
 
 #include "../constant.h"
 
-#include "Neural/Neural.hpp"
+#include "Layer/Layer.hpp"
+#include "Matrix/Matrix.hpp"
+#include "Arena/Arena.hpp"
+#include "Connection/Connection.hpp"
+#include "Batch/Batch.hpp"
+#include "ThreadPool/ThreadPool.hpp"
+#include "TrainingConfig/TrainingConfig.hpp"
+#include "Scratch/Scratch.hpp"
+#include "MappedFile/MappedFile.hpp"
+#include "Profiler/Profiler.hpp"
 #include "Functions/Loss/Loss.hpp"
+#include "Functions/Optimizer/Optimizer.hpp"
 
 /**
  * The neural handler the list of all neurals
+ *
+ * Instantiated for float (half the memory and bandwidth, twice the SIMD width) and double
  */
+template<typename T>
 class Network {
 protected:
 	/**
@@ -55,22 +72,70 @@ protected:
 	/**
 	 * The representation of neural layers
 	 */
-	std::vector<std::vector<std::shared_ptr<Neural>>> neurals;
+	std::vector<Layer<T>> layers;
+
+	/**
+	 * Storage of the layers: weights and biases of every layer (contiguous), then the
+	 * buffers of the neurals (freed at once with the network)
+	 */
+	Arena<T> arena;
+
+	/**
+	 * Alpha value used in weight computation, usualy between 0.0 and 1.0 [default = 0.01]
+	 */
+	T learningRate;
+
+	/**
+	 * Working buffers of the mini-batch learning (one by shard of the batch)
+	 */
+	std::vector<Batch<T>> batches;
 
 	/**
-	 * The representation of neural links
+	 * Threads of the data-parallel learning and of the neurals of the wide layers of one sample,
+	 * can be shared with other networks (none: single thread)
 	 */
-	std::vector<std::vector<std::shared_ptr<Link>>> links;
+	std::shared_ptr<ThreadPool> threadPool;
+
+	/**
+	 * Random generator of the initial weights (owned by the network: no global state)
+	 */
+	std::mt19937_64 generator;
 
 	/**
 	 * Result of loss function
 	 */
-	double loss;
+	T loss;
 
 	/**
 	 * Loss function
 	 */
-	std::unique_ptr<Loss> lossFunction;
+	std::unique_ptr<Loss<T>> lossFunction;
+
+	/**
+	 * Loss function type
+	 */
+	LossFunctionType lossFunctionType;
+
+	/**
+	 * Update rule of the weights and biases
+	 */
+	std::unique_ptr<Optimizer<T>> optimizer;
+
+	/**
+	 * Offset of the weights of each layer in the parameters of the network (biases follow
+	 * the weights, as in the arena: see Layer::getParametersCount)
+	 */
+	std::vector<size_t> parametersOffsets;
+
+	/**
+	 * Mapped model file (the weights of the layers are used in place)
+	 */
+	std::shared_ptr<MappedFile> mappedFile;
+
+	/**
+	 * Time and bytes by layer and by phase (empty unless ANN_PROFILE is defined)
+	 */
+	mutable Profiler profiler;
 
 protected:
 	/**
@@ -78,11 +143,84 @@ protected:
 	 */
 	void backPropagation();
 
+	/**
+	 * Compute the neurals of a wide layer by ranges on the threads of the pool, the run returns
+	 * when every range is done (one range on the calling thread without pool or for a small layer,
+	 * every range on the calling thread when the pool is busy: see ThreadPool::tryRun)
+	 * @param rowsCount number of neurals of the layer
+	 * @param rowCost number of multiply-adds by neural
+	 * @param rows computation of the neurals first .. last - 1
+	 */
+	void splitRows(size_t rowsCount, size_t rowCost, const std::function<void(size_t, size_t)>& rows) const;
+
+	/**
+	 * Compute the neurals of a layer by ranges (see splitRows), a neural costs its links
+	 * @param layer computed layer
+	 * @param rows computation of the neurals first .. last - 1
+	 */
+	void splitRows(const Layer<T>& layer, const std::function<void(size_t, size_t)>& rows) const;
+
+	/**
+	 * Compute the gradients of a shard of a mini-batch
+	 * @param inputValues input values of the mini-batch
+	 * @param expectedValues expected values of the mini-batch
+	 * @param first first row of the shard
+	 * @param count number of rows of the shard
+	 * @param batch working buffers of the shard
+	 * @return loss of the shard
+	 */
+	T computeGradients(const Matrix<T>& inputValues, const Matrix<T>& expectedValues, size_t first, size_t count, Batch<T>& batch);
+
+	/**
+	 * Check if the network is ready and if the input values are enough
+	 * @param inputValuesCount number of input values
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void checkEstimate(size_t inputValuesCount) const;
+
+	/**
+	 * Estimate the bytes read and written by a phase of a layer (measures of the profiler)
+	 * @param layer layer index
+	 * @param phase phase
+	 * @param rowsCount number of samples
+	 * @return number of bytes
+	 */
+	uint64_t getBytes(size_t layer, ProfilePhase phase, size_t rowsCount) const;
+
+	/**
+	 * Compute forward propagation of one sample (weights are only read)
+	 * @param inputValues input values
+	 * @param scratch working buffers
+	 * @return output values of the last layer (in scratch)
+	 */
+	const T* propagate(const T* inputValues, Scratch<T>& scratch) const;
+
+	/**
+	 * Compute forward propagation of a batch of samples (weights are only read)
+	 * @param inputValues input values (one row by sample, as many columns as the input layer)
+	 * @param scratch working buffers
+	 * @return output values of the last layer (in scratch)
+	 */
+	const Matrix<T>& propagate(const Matrix<T>& inputValues, Scratch<T>& scratch) const;
+
 	/**
 	 * Get class max
+	 * @param outputValues output values of the last layer
 	 * @return max class
 	 */
-	int getClassMax();
+	int getClassMax(const T* outputValues) const;
+
+	/**
+	 * Set loss function
+	 * @param lossFunctionType loss function type
+	 */
+	void setLossFunction(LossFunctionType lossFunctionType);
+
+	/**
+	 * Compute the offsets of the parameters of the layers and allocate the state of the optimizer
+	 */
+	void reserveOptimizer();
 
 	/**
 	 * Add layer
@@ -90,45 +228,57 @@ protected:
 	 * @param nbN number of neurals
 	 * @param aT aggregation type
 	 * @param eT excitation type
+	 * @param connection links with the previous layer
 	 */
-	void addLayer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT);
+	void addLayer(NeuralType t, unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection = Connection());
 
 	/**
-	 * Get neural in the matrix
-	 * @param layer layer index
-	 * @param neuralPos neural index
-	 * @return neural pointer
-	 * @throw invalid_argument if bounds are not correct
+	 * Set the links between the layers (full or sparse, see Connection) and allocate the layers
+	 * @throw invalid_argument if a connection does not match its layers
 	 */
-	std::shared_ptr<Neural>& getNeuralAt(size_t layer, size_t neuralPos);
+	void connectLayers();
 
 	/**
-	 * Get neural in the matrix in the last layer
-	 * @param neuralPos neural index
-	 * @return neural pointer
+	 * Set new links of the connected layers and rebuild the arena: the weights of the kept
+	 * links and the biases are copied, the state of the optimizer is reset
+	 * @param rowOffsets row offsets of each layer (index of the layer, empty: full connection)
+	 * @param columns columns of each layer (index of the layer)
+	 * @throw invalid_argument if the rows are not valid
 	 */
-	std::shared_ptr<Neural>& getNeuralAtTheLastLayer(size_t neuralPos);
+	void relinkLayers(std::vector<std::vector<unsigned int>> rowOffsets, std::vector<std::vector<unsigned int>> columns);
 
+public:
 	/**
-	 * Get link in the matrix
-	 * @param layer layer index
-	 * @param neuralPos neural index
-	 * @return link pointer
-	 * @throw invalid_argument if bounds are not correct
+	 * Constructor
+	 * @param learningRate alpha value used in weight computation
+	 * @param lossFunctionType loss function type
+	 * @param optimizerType update rule of the weights
 	 */
-	std::shared_ptr<Link>& getLinkAt(size_t layer, size_t linkPos);
+	Network(T learningRate = (T) 0.01, LossFunctionType lossFunctionType = LossFunctionType::MSE, OptimizerType optimizerType = OptimizerType::SGD);
 
 	/**
-	 * Set full connection of network
+	 * Constructor
+	 * @param config hyperparameters, seed and threads of the learning
 	 */
-	void fullConnection();
+	explicit Network(const TrainingConfig<T>& config);
 
-public:
 	/**
-	 * Constructor
+	 * Seed the random generator of the network (used by the layers connected afterwards)
+	 * @param seed seed
+	 */
+	void setSeed(uint64_t seed);
+
+	/**
+	 * Set learning rate
 	 * @param learningRate alpha value used in weight computation
 	 */
-	Network(double learningRate = 0.01, LossFunctionType lossFunctionType = LossFunctionType::MSE);
+	void setLearningRate(T learningRate);
+
+	/**
+	 * Get learning rate
+	 * @return alpha value used in weight computation
+	 */
+	T getLearningRate() const;
 
 	/**
 	 * Add input layer
@@ -142,42 +292,241 @@ public:
 	 * @param nbN number of neurals
 	 * @param aT aggregation type
 	 * @param eT excitation type
+	 * @param connection links with the previous layer [default = full]
 	 * @throw logic_error if input layer is not already set or output is already set
 	 */
-	void addLayer(unsigned int nbN, AggregationType aT, ExcitationType eT);
+	void addLayer(unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection = Connection());
 
 	/**
 	 * Add last layer and set links between layers
 	 * @param nbN number of neurals
 	 * @param aT aggregation type
 	 * @param eT excitation type
+	 * @param connection links with the previous layer [default = full]
 	 * @throw logic_error if input layer is not already set or output is already set
+	 * @throw invalid_argument if a connection does not match its layers
 	 */
-	void addOutputLayer(unsigned int nbN, AggregationType aT, ExcitationType eT);
+	void addOutputLayer(unsigned int nbN, AggregationType aT, ExcitationType eT, const Connection& connection = Connection());
 
 	/**
-	 * Compute learning
+	 * Compute learning (the neurals of the wide layers are split on the threads of the pool)
 	 * @param inputValues input values
 	 * @param expectedValues expected values
 	 * @throw logic_error if input and output error are not set
 	 * @throw invalid_argument if bounds are not correct
 	 */
-	void learn(const std::vector<double>& inputValues, const std::vector<double>& expectedValues);
+	void learn(const std::vector<T>& inputValues, const std::vector<T>& expectedValues);
+
+	/**
+	 * Set the update rule of the weights (with its default hyperparameters), the state of the
+	 * previous optimizer is lost
+	 * @param optimizerType optimizer type
+	 */
+	void setOptimizer(OptimizerType optimizerType);
+
+	/**
+	 * Set a custom update rule of the weights, the state of the previous optimizer is lost
+	 * @param optimizer optimizer
+	 * @throw invalid_argument if the optimizer is null
+	 */
+	void setOptimizer(std::unique_ptr<Optimizer<T>> optimizer);
+
+	/**
+	 * Set the number of threads of the mini-batch learning and of the wide layers of one sample
+	 * (in a pool owned by this network)
+	 * @param threadsCount number of threads (1: no thread, 0: one by core)
+	 */
+	void setThreadsCount(unsigned int threadsCount);
+
+	/**
+	 * Set the threads of the mini-batch learning and of the wide layers of one sample (the
+	 * neurals of a layer are split in ranges, with a barrier between two layers), a pool can be
+	 * shared by several networks: their mini-batches run one after the other on all the threads,
+	 * a layer of one sample runs on the calling thread while the pool is busy (from a task of the
+	 * pool it uses, a network computes on the thread of the task)
+	 * @param threadPool threads (null: single thread)
+	 */
+	void setThreadPool(std::shared_ptr<ThreadPool> threadPool);
+
+	/**
+	 * Compute learning on a mini-batch: gradients are accumulated over all the samples
+	 * and the weights are updated once (with the mean gradient)
+	 *
+	 * With several threads, the batch is split in one shard by thread, each shard computes
+	 * its gradients in its own buffers and the gradients are summed by a pairwise tree
+	 * in a fixed order (the result only depends on the number of threads)
+	 * @param inputValues input values (one row by sample)
+	 * @param expectedValues expected values (one row by sample)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void learnBatch(const Matrix<T>& inputValues, const Matrix<T>& expectedValues);
+
+	/**
+	 * Prune the smallest weights of each connected layer (magnitude pruning): the kept links
+	 * become the sparse links of the layer, so the learning can go on to fine-tune them
+	 * (the pruned links stay at zero), the biases are kept
+	 * @param sparsity ratio of pruned links of each layer (of all the links of a full
+	 * connection, a layer with less links is unchanged), in [0, 1[
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if the sparsity is not valid
+	 */
+	void prune(double sparsity);
+
+	/**
+	 * Prune the smallest weights of each connected layer, with a sparsity by layer
+	 * @param sparsities ratio of pruned links of each layer (one by connected layer)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if the sparsities are not valid
+	 */
+	void prune(const std::vector<double>& sparsities);
+
+	/**
+	 * Choose the faster weights of each sparse layer for the estimation: the sparse kernel
+	 * and the dense kernel (pruned links at zero) are timed on the samples and the layer
+	 * becomes full if the dense kernel is faster (a pruned link of a full layer is learned
+	 * again if the learning goes on)
+	 * @param inputValues samples of the timings (one row by sample: the layers are chosen
+	 * for the estimation of one sample if there is only one row, for batches otherwise)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void selectKernels(const Matrix<T>& inputValues);
+
+	/**
+	 * Compute estimation (reentrant: the weights are only read, buffers are local to the thread)
+	 * @param inputValues input values
+	 * @return the max class
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int estimate(const std::vector<T>& inputValue) const;
 
 	/**
-	 * Compute estimation
+	 * Compute estimation in caller buffers (reentrant: the weights are only read)
 	 * @param inputValues input values
+	 * @param outputValues output values of the last layer
+	 * @param scratch working buffers (one by thread)
 	 * @return the max class
 	 * @throw logic_error if input and output error are not set
 	 * @throw invalid_argument if bounds are not correct
 	 */
-	int estimate(const std::vector<double>& inputValue);
+	int estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues, Scratch<T>& scratch) const;
+
+	/**
+	 * Compute estimation of a batch of samples (reentrant: the weights are only read)
+	 * @param inputValues input values (one row by sample)
+	 * @param outputValues output values of the last layer (one row by sample)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues) const;
+
+	/**
+	 * Compute estimation of a batch of samples and the k best classes of each sample
+	 * (reentrant: the weights are only read)
+	 * @param inputValues input values (one row by sample)
+	 * @param outputValues output values of the last layer (one row by sample)
+	 * @param k number of best classes by sample (at most the number of outputs)
+	 * @param topClasses best classes by decreasing score (one row of k by sample)
+	 * @param topScores scores of the best classes (one row of k by sample)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues, size_t k, std::vector<unsigned int>& topClasses, Matrix<T>& topScores) const;
+
+	/**
+	 * Compute the loss of a batch of samples without learning (reentrant: the weights are only
+	 * read, buffers are local to the thread)
+	 * @param inputValues input values (one row by sample)
+	 * @param expectedValues expected values (one row by sample)
+	 * @param outputValues output values of the last layer (one row by sample)
+	 * @return loss value (mean of the samples)
+	 * @throw logic_error if input and output error are not set
+	 * @throw invalid_argument if bounds are not correct or the batch is empty
+	 */
+	T evaluate(const Matrix<T>& inputValues, const Matrix<T>& expectedValues, Matrix<T>& outputValues) const;
+
+	/**
+	 * Save the topology and the weights in a binary model file (see Model)
+	 * @param path path of the file
+	 * @throw logic_error if input and output error are not set
+	 * @throw runtime_error if the file can not be written
+	 */
+	void save(const std::string& path) const;
+
+	/**
+	 * Save the topology with a copy of the weights and the biases in a binary model file (only
+	 * the topology of the network is read: it can learn meanwhile)
+	 * @param path path of the file
+	 * @param parameters weights and biases copied by copyParameters
+	 * @throw logic_error if input and output error are not set
+	 * @throw runtime_error if the file can not be written
+	 */
+	void save(const std::string& path, const T* parameters) const;
+
+	/**
+	 * Get number of values of the weights and the biases of all the layers (see copyParameters)
+	 * @return number of values
+	 */
+	size_t getParametersCount() const;
+
+	/**
+	 * Copy the weights and the biases of all the layers, each layer at its offset in the arena
+	 * (one copy of the start of the arena unless the weights are mapped from a model file)
+	 * @param parameters copy of the parameters (getParametersCount values)
+	 * @throw logic_error if input and output error are not set
+	 */
+	void copyParameters(T* parameters) const;
+
+	/**
+	 * Set the weights and the biases of all the layers from a copy (see copyParameters), the
+	 * state of the optimizer is kept
+	 * @param parameters copy of the parameters (getParametersCount values)
+	 * @throw logic_error if input and output error are not set
+	 */
+	void setParameters(const T* parameters);
+
+	/**
+	 * Load a binary model file in an empty network, the file is mapped in memory and
+	 * the weights are used in place (no copy: pages are shared between the processes
+	 * loading the same file and copied only if the network learns)
+	 * @param path path of the file
+	 * @throw logic_error if the network is already built
+	 * @throw runtime_error if the file can not be mapped or is not a valid model
+	 */
+	void load(const std::string& path);
+
+	/**
+	 * Get number of layers
+	 * @return number of layers (with the input layer)
+	 */
+	size_t getLayersCount() const;
+
+	/**
+	 * Get a layer
+	 * @param i layer index (0 for the input layer)
+	 * @return layer
+	 * @throw out_of_range if the layer does not exist
+	 */
+	const Layer<T>& getLayer(size_t i) const;
+
+	/**
+	 * Get profiler of the learning and the estimation (empty unless ANN_PROFILE is defined)
+	 * @return profiler
+	 */
+	const Profiler& getProfiler() const;
+
+	/**
+	 * Reset the measures of the profiler
+	 */
+	void resetProfiler();
 
 	/**
 	 * Get loss value
 	 * @return loss value
 	 */
-	double getLoss();
+	T getLoss();
 
 	/**
 	 * Print layers
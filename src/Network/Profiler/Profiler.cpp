@@ -0,0 +1,96 @@
+/*
+ * Profiler.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Profiler.hpp"
+
+Profiler::Profiler() {
+	layersCount = 0;
+}
+
+bool Profiler::isEnabled() {
+#if defined(ANN_PROFILE)
+	return true;
+#else
+	return false;
+#endif
+}
+
+std::string Profiler::getName(ProfilePhase phase) {
+	switch (phase) {
+	case ProfilePhase::ESTIMATE:
+		return "ESTIMATE";
+	case ProfilePhase::FORWARD:
+		return "FORWARD";
+	case ProfilePhase::OUTPUT_DELTA:
+		return "OUTPUT_DELTA";
+	case ProfilePhase::DELTA:
+		return "DELTA";
+	case ProfilePhase::GRADIENT:
+		return "GRADIENT";
+	case ProfilePhase::UPDATE:
+		return "UPDATE";
+	default:
+		return "UNKNOWN";
+	}
+}
+
+void Profiler::resize(size_t layersCount) {
+	this->layersCount = layersCount;
+	entries.reset(new Entry[layersCount * PHASES_COUNT]);
+	reset();
+}
+
+void Profiler::reset() {
+	for (size_t i = 0; i < layersCount * PHASES_COUNT; ++i) {
+		entries[i].callsCount = 0;
+		entries[i].nanoseconds = 0;
+		entries[i].bytes = 0;
+	}
+}
+
+void Profiler::record(size_t layer, ProfilePhase phase, uint64_t nanoseconds, uint64_t bytes) {
+	if (layer >= layersCount) {
+		return;
+	}
+	Entry& entry = entries[layer * PHASES_COUNT + (size_t) phase];
+	entry.callsCount.fetch_add(1, std::memory_order_relaxed);
+	entry.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+	entry.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+std::vector<Profiler::Record> Profiler::getRecords() const {
+	std::vector<Record> records;
+	for (size_t layer = 0; layer < layersCount; ++layer) {
+		for (size_t phase = 0; phase < PHASES_COUNT; ++phase) {
+			const Entry& entry = entries[layer * PHASES_COUNT + phase];
+			uint64_t callsCount = entry.callsCount.load(std::memory_order_relaxed);
+			if (callsCount > 0) {
+				records.push_back({ layer, (ProfilePhase) phase, callsCount, entry.nanoseconds.load(std::memory_order_relaxed), entry.bytes.load(std::memory_order_relaxed) });
+			}
+		}
+	}
+	return records;
+}
+
+void Profiler::writeJson(std::ostream& out) const {
+	std::vector<Record> records = getRecords();
+	out << "{\"enabled\": " << (isEnabled() ? "true" : "false") << ", \"records\": [";
+	for (size_t i = 0; i < records.size(); ++i) {
+		const Record& r = records.at(i);
+		double seconds = r.nanoseconds * 1e-9;
+		out << (i == 0 ? "\n" : ",\n") << "  {\"layer\": " << r.layer << ", \"phase\": \"" << getName(r.phase) << "\", \"calls\": " << r.callsCount
+			<< ", \"seconds\": " << seconds << ", \"bytes\": " << r.bytes << ", \"bytesPerSecond\": " << (seconds > 0 ? r.bytes / seconds : 0) << "}";
+	}
+	out << "\n]}" << std::endl;
+}
+
+void Profiler::writeCsv(std::ostream& out) const {
+	out << "layer,phase,calls,seconds,bytes" << std::endl;
+	for (const Record& r : getRecords()) {
+		out << r.layer << "," << getName(r.phase) << "," << r.callsCount << "," << r.nanoseconds * 1e-9 << "," << r.bytes << std::endl;
+	}
+}
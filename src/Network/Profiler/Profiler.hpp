@@ -0,0 +1,154 @@
+/*
+ * Profiler.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef PROFILER_PROFILER_HPP_
+#define PROFILER_PROFILER_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <string>
+#include <ostream>
+
+#include "../../constant.h"
+
+/**
+ * Scope measured by a profiler (define ANN_PROFILE to enable the measures, otherwise the
+ * macro and its arguments compile to nothing)
+ */
+#if defined(ANN_PROFILE)
+#define ANN_PROFILE_CONCAT_(a, b) a##b
+#define ANN_PROFILE_CONCAT(a, b) ANN_PROFILE_CONCAT_(a, b)
+#define ANN_PROFILE_SCOPE(profiler, layer, phase, bytes) Profiler::Scope ANN_PROFILE_CONCAT(profileScope, __LINE__)((profiler), (layer), (phase), (bytes))
+#else
+#define ANN_PROFILE_SCOPE(profiler, layer, phase, bytes) ((void) 0)
+#endif
+
+/**
+ * Wall time, calls count and bytes touched by layer and by phase
+ *
+ * Measures can be recorded by several threads at once (relaxed atomic counters)
+ */
+class Profiler {
+public:
+	/**
+	 * Totals of a layer and a phase
+	 */
+	struct Record {
+		size_t layer;
+		ProfilePhase phase;
+		uint64_t callsCount;
+		uint64_t nanoseconds;
+		uint64_t bytes;
+	};
+
+	/**
+	 * Measure of a scope (recorded by the destructor)
+	 */
+	class Scope {
+	protected:
+		Profiler& profiler;
+		size_t layer;
+		ProfilePhase phase;
+		uint64_t bytes;
+		std::chrono::steady_clock::time_point start;
+
+	public:
+		Scope(Profiler& profiler, size_t layer, ProfilePhase phase, uint64_t bytes) : profiler(profiler), layer(layer), phase(phase), bytes(bytes), start(std::chrono::steady_clock::now()) {}
+		~Scope() { profiler.record(layer, phase, (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count(), bytes); }
+
+		Scope(const Scope&) = delete;
+		Scope& operator=(const Scope&) = delete;
+	};
+
+	/**
+	 * Number of phases
+	 */
+	static const size_t PHASES_COUNT = (size_t) ProfilePhase::UPDATE + 1;
+
+protected:
+	/**
+	 * Counters of a layer and a phase
+	 */
+	struct Entry {
+		std::atomic<uint64_t> callsCount;
+		std::atomic<uint64_t> nanoseconds;
+		std::atomic<uint64_t> bytes;
+	};
+
+	/**
+	 * Counters (layersCount x PHASES_COUNT)
+	 */
+	std::unique_ptr<Entry[]> entries;
+
+	/**
+	 * Number of layers
+	 */
+	size_t layersCount;
+
+public:
+	/**
+	 * Constructor
+	 */
+	Profiler();
+
+	/**
+	 * Are the measures compiled (ANN_PROFILE is defined)
+	 * @return true if the scopes are measured
+	 */
+	static bool isEnabled();
+
+	/**
+	 * Get name of a phase
+	 * @param phase phase
+	 * @return name
+	 */
+	static std::string getName(ProfilePhase phase);
+
+	/**
+	 * Allocate the counters of the layers and reset them (not thread-safe)
+	 * @param layersCount number of layers
+	 */
+	void resize(size_t layersCount);
+
+	/**
+	 * Reset the counters (not thread-safe)
+	 */
+	void reset();
+
+	/**
+	 * Add a measure (ignored if the layer is unknown)
+	 * @param layer layer index
+	 * @param phase phase
+	 * @param nanoseconds wall time
+	 * @param bytes bytes read and written
+	 */
+	void record(size_t layer, ProfilePhase phase, uint64_t nanoseconds, uint64_t bytes);
+
+	/**
+	 * Get totals of every layer and phase called at least once
+	 * @return totals by layer then by phase
+	 */
+	std::vector<Record> getRecords() const;
+
+	/**
+	 * Write the totals as JSON
+	 * @param out output stream
+	 */
+	void writeJson(std::ostream& out) const;
+
+	/**
+	 * Write the totals as CSV (with a header line)
+	 * @param out output stream
+	 */
+	void writeCsv(std::ostream& out) const;
+};
+
+#endif /* PROFILER_PROFILER_HPP_ */
@@ -0,0 +1,123 @@
+/*
+ * Pruner.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+
+#include "Pruner.hpp"
+
+template<typename T>
+Pruner<T>::Pruner(Network<T>& network, const Matrix<T>& inputValues, const std::vector<unsigned int>& expectedClasses) : network(network), inputValues(inputValues), expectedClasses(expectedClasses) {
+	// Check if the network is ready
+	size_t layersCount = network.getLayersCount();
+	if (layersCount < 2 || network.getLayer(layersCount - 1).getType() != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("The network is not complete");
+	}
+
+	// Control input parameter: evaluation set
+	if (inputValues.getRowsCount() == 0) {
+		throw std::invalid_argument("The evaluation set should not be empty");
+	}
+	if (inputValues.getColsCount() < network.getLayer(0).getNeuralsCount()) {
+		throw std::invalid_argument("The evaluation matrix should have, at least, as many columns as the input layer");
+	}
+	if (expectedClasses.size() != inputValues.getRowsCount()) {
+		throw std::invalid_argument("The expected classes vector should have as many values as the input values matrix rows");
+	}
+}
+
+template<typename T>
+void Pruner<T>::setFineTuning(std::function<void(Network<T>&)> fineTuning) {
+	this->fineTuning = fineTuning;
+}
+
+template<typename T>
+PruningReport Pruner<T>::measure(double sparsity) const {
+	typedef std::chrono::steady_clock Clock;
+
+	PruningReport report = PruningReport();
+	report.sparsity = sparsity;
+	report.samplesCount = inputValues.getRowsCount();
+
+	// Links kept (non-zero weights, the full layers keep the pruned links at zero) of all the
+	// links of full connections
+	size_t fullLinksCount = 0;
+	for (size_t i = 1; i < network.getLayersCount(); ++i) {
+		const Layer<T>& layer = network.getLayer(i);
+		const T* weights = layer.getWeights();
+		for (size_t p = 0; p < layer.getLinksCount(); ++p) {
+			report.linksCount += (weights[p] != T(0));
+		}
+		report.sparseLayersCount += layer.isSparse();
+		fullLinksCount += (size_t) layer.getNeuralsCount() * layer.getInputsCount();
+	}
+	report.density = report.linksCount / (double) fullLinksCount;
+
+	// Accuracy and throughput of the batch estimation
+	Matrix<T> outputValues;
+	Matrix<T> topScores;
+	std::vector<unsigned int> topClasses;
+	Clock::time_point start = Clock::now();
+	network.estimateBatch(inputValues, outputValues, 1, topClasses, topScores);
+	double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	report.samplesPerSecond = report.samplesCount / std::max(seconds, 1e-9);
+
+	size_t correct = 0;
+	for (size_t r = 0; r < report.samplesCount; ++r) {
+		correct += (topClasses[r] == expectedClasses[r]);
+	}
+	report.accuracy = correct / (double) report.samplesCount;
+
+	// Latency of the estimation of one sample (at most 1000 samples)
+	const size_t LATENCY_SAMPLES = 1000;
+	size_t latencyCount = std::min(LATENCY_SAMPLES, report.samplesCount);
+	size_t inputsCount = network.getLayer(0).getNeuralsCount();
+	std::vector<T> sample(inputsCount);
+	std::vector<T> sampleOutputs;
+	Scratch<T> scratch;
+	double totalSeconds = 0;
+	for (size_t r = 0; r < latencyCount; ++r) {
+		std::copy(inputValues.row(r), inputValues.row(r) + inputsCount, sample.begin());
+		start = Clock::now();
+		network.estimate(sample, sampleOutputs, scratch);
+		totalSeconds += std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	report.latency = totalSeconds / latencyCount;
+	return report;
+}
+
+template<typename T>
+std::vector<PruningReport> Pruner<T>::run(const std::vector<double>& sparsities) {
+	// Control input parameter: increasing sparsities (each level prunes the previous one)
+	for (size_t i = 0; i < sparsities.size(); ++i) {
+		if (!(sparsities[i] >= 0 && sparsities[i] < 1)) {
+			throw std::invalid_argument("The sparsity should be in [0, 1[");
+		}
+		if (i > 0 && sparsities[i] < sparsities[i - 1]) {
+			throw std::invalid_argument("The sparsities should be increasing");
+		}
+	}
+
+	// Kernels chosen for the estimation of one sample
+	Matrix<T> sample(1, inputValues.getColsCount());
+	std::copy(inputValues.row(0), inputValues.row(0) + inputValues.getColsCount(), sample.row(0));
+
+	std::vector<PruningReport> reports;
+	for (double sparsity : sparsities) {
+		network.prune(sparsity);
+		if (fineTuning) {
+			fineTuning(network);
+		}
+		network.selectKernels(sample);
+		reports.push_back(measure(sparsity));
+	}
+	return reports;
+}
+
+template class Pruner<float>;
+template class Pruner<double>;
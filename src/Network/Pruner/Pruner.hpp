@@ -0,0 +1,126 @@
+/*
+ * Pruner.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef PRUNER_PRUNER_HPP_
+#define PRUNER_PRUNER_HPP_
+
+#include <vector>
+#include <functional>
+
+#include "../Network.hpp"
+#include "../Matrix/Matrix.hpp"
+
+/**
+ * Accuracy and latency of a network at a sparsity level
+ */
+struct PruningReport {
+	/**
+	 * Ratio of pruned links of each layer
+	 */
+	double sparsity;
+
+	/**
+	 * Number of links kept in the network (non-zero weights)
+	 */
+	size_t linksCount;
+
+	/**
+	 * Ratio of links kept in the network (of all the links of full connections)
+	 */
+	double density;
+
+	/**
+	 * Number of layers using the sparse kernels
+	 */
+	size_t sparseLayersCount;
+
+	/**
+	 * Number of evaluated samples
+	 */
+	size_t samplesCount;
+
+	/**
+	 * Accuracy (ratio of estimations equal to the expected class)
+	 */
+	double accuracy;
+
+	/**
+	 * Mean time of the estimation of one sample (in seconds)
+	 */
+	double latency;
+
+	/**
+	 * Samples estimated by second by batches
+	 */
+	double samplesPerSecond;
+};
+
+/**
+ * Magnitude pruning of a trained network by increasing sparsity levels
+ *
+ * Each level prunes the smallest weights of each layer (see Network::prune), fine-tunes the
+ * kept links if a fine-tuning is set, chooses the faster kernel of each layer for the
+ * estimation of one sample (see Network::selectKernels) and measures the network: the
+ * network is left at the last level, ready to be saved as an inference model
+ */
+template<typename T>
+class Pruner {
+protected:
+	/**
+	 * Pruned network
+	 */
+	Network<T>& network;
+
+	/**
+	 * Input values of the evaluation set (one row by sample)
+	 */
+	const Matrix<T>& inputValues;
+
+	/**
+	 * Expected class of each sample of the evaluation set
+	 */
+	const std::vector<unsigned int>& expectedClasses;
+
+	/**
+	 * Learning of the kept links after each pruning (none: no fine-tuning)
+	 */
+	std::function<void(Network<T>&)> fineTuning;
+
+public:
+	/**
+	 * Constructor (the network and the evaluation set are kept by reference)
+	 * @param network trained network
+	 * @param inputValues input values of the evaluation set (one row by sample)
+	 * @param expectedClasses expected class of each sample
+	 * @throw logic_error if the network is not complete
+	 * @throw invalid_argument if the evaluation set is empty or its bounds are not correct
+	 */
+	Pruner(Network<T>& network, const Matrix<T>& inputValues, const std::vector<unsigned int>& expectedClasses);
+
+	/**
+	 * Set the learning of the kept links after each pruning
+	 * @param fineTuning learning of the network (none: no fine-tuning)
+	 */
+	void setFineTuning(std::function<void(Network<T>&)> fineTuning);
+
+	/**
+	 * Measure the network as it is on the evaluation set
+	 * @param sparsity sparsity level of the report
+	 * @return accuracy and latency
+	 */
+	PruningReport measure(double sparsity) const;
+
+	/**
+	 * Prune, fine-tune and measure the network at each sparsity level
+	 * @param sparsities ratio of pruned links of each layer by level (increasing, in [0, 1[)
+	 * @return report of each level
+	 * @throw invalid_argument if the sparsities are not valid
+	 */
+	std::vector<PruningReport> run(const std::vector<double>& sparsities);
+};
+
+#endif /* PRUNER_PRUNER_HPP_ */
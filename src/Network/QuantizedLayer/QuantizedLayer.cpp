@@ -0,0 +1,153 @@
+/*
+ * QuantizedLayer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "QuantizedLayer.hpp"
+#include "../Kernel/Kernel.hpp"
+
+#include "../Functions/Excitation/ExcitationKernel.hpp"
+
+template<typename T>
+QuantizedLayer::QuantizedLayer(const Layer<T>& layer, float inputScale, QuantizationType qT) {
+	if (layer.getType() == NeuralType::INPUT_NEURAL || layer.getAggregationType() != AggregationType::SUM) {
+		throw std::invalid_argument("Only connected sum layers can be quantized");
+	}
+
+	neuralsCount = layer.getNeuralsCount();
+	inputsCount = layer.getInputsCount();
+	paddedInputsCount = getPaddedCount(inputsCount);
+	this->inputScale = inputScale;
+
+	// Scales of the weights: max |w| of each neural or of the whole layer
+	const T* w = layer.getWeights();
+	std::vector<double> maxAbs(neuralsCount, 0.0);
+	if (layer.isSparse()) {
+		rowOffsets = layer.getRowOffsets();
+		columns = layer.getColumns();
+		for (size_t i = 0; i < neuralsCount; ++i) {
+			for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+				maxAbs[i] = std::max(maxAbs[i], (double) std::fabs(w[p]));
+			}
+		}
+	} else {
+		for (size_t i = 0; i < neuralsCount; ++i) {
+			for (size_t j = 0; j < inputsCount; ++j) {
+				maxAbs[i] = std::max(maxAbs[i], (double) std::fabs(w[i * inputsCount + j]));
+			}
+		}
+	}
+	if (qT == QuantizationType::PER_LAYER) {
+		double layerMaxAbs = neuralsCount > 0 ? *std::max_element(maxAbs.begin(), maxAbs.end()) : 0.0;
+		std::fill(maxAbs.begin(), maxAbs.end(), layerMaxAbs);
+	}
+
+	scales.resize(neuralsCount);
+	if (layer.isSparse()) {
+		// Quantized links in the CSR order of the layer (no padding, no sums)
+		weights.resize(layer.getLinksCount());
+		for (size_t i = 0; i < neuralsCount; ++i) {
+			float weightsScale = getScale(maxAbs[i]);
+			float inverse = 1.0f / weightsScale;
+			for (size_t p = rowOffsets[i]; p < rowOffsets[i + 1]; ++p) {
+				float q = std::min(std::max((float) w[p] * inverse, -127.0f), 127.0f);
+				weights[p] = (int8_t) (q < 0.0f ? q - 0.5f : q + 0.5f);
+			}
+			scales[i] = weightsScale * inputScale;
+		}
+	} else {
+		// Quantized weights (rows padded with zeros) and their sums
+		weights.assign(neuralsCount * paddedInputsCount, 0);
+		rowSums.assign(neuralsCount, 0);
+		for (size_t i = 0; i < neuralsCount; ++i) {
+			float weightsScale = getScale(maxAbs[i]);
+			quantize(w + i * inputsCount, inputsCount, weightsScale, weights.data() + i * paddedInputsCount);
+			for (size_t j = 0; j < inputsCount; ++j) {
+				rowSums[i] += weights[i * paddedInputsCount + j];
+			}
+			scales[i] = weightsScale * inputScale;
+		}
+	}
+	biases.assign(layer.getBiases(), layer.getBiases() + neuralsCount);
+	excitationType = layer.getExcitationType();
+}
+
+void QuantizedLayer::forwardPropagation(const int8_t* previous, int32_t* accumulators, float* outputs, int8_t* quantizedOutputs, float outputScale) const {
+	// Int32 sums of the products of the quantized values
+	if (rowOffsets.empty()) {
+		Kernel::gemvInt8(neuralsCount, paddedInputsCount, weights.data(), paddedInputsCount, previous, rowSums.data(), accumulators);
+	} else {
+		Kernel::spmvInt8(neuralsCount, weights.data(), rowOffsets.data(), columns.data(), previous, accumulators);
+	}
+
+	// Softmax is normalized over the layer: dequantize every neural, then excite and quantize the whole layer
+	if (excitationType == ExcitationType::SOFTMAX) {
+		for (size_t i = 0; i < neuralsCount; ++i) {
+			outputs[i] = accumulators[i] * scales[i] + biases[i];
+		}
+		ExcitationKernel::softmax(outputs, outputs, neuralsCount);
+		if (quantizedOutputs) {
+			quantize(outputs, neuralsCount, outputScale, quantizedOutputs);
+		}
+		return;
+	}
+
+	// Dequantize, excite and quantize by blocks of neurals (a block stays in L1)
+	const size_t BLOCK = 256;
+	for (size_t first = 0; first < neuralsCount; first += BLOCK) {
+		size_t count = std::min(BLOCK, neuralsCount - first);
+		for (size_t i = first; i < first + count; ++i) {
+			outputs[i] = accumulators[i] * scales[i] + biases[i];
+		}
+		ExcitationKernel::compute(excitationType, outputs + first, outputs + first, count);
+		if (quantizedOutputs) {
+			// The blocks are multiple of the padding: only the last block pads
+			quantize(outputs + first, count, outputScale, quantizedOutputs + first);
+		}
+	}
+}
+
+template<typename T>
+void QuantizedLayer::quantize(const T* values, size_t count, float scale, int8_t* quantized) {
+	float inverse = 1.0f / scale;
+	for (size_t i = 0; i < count; ++i) {
+		float q = std::min(std::max((float) values[i] * inverse, -127.0f), 127.0f);
+		quantized[i] = (int8_t) (q < 0.0f ? q - 0.5f : q + 0.5f);
+	}
+	std::fill(quantized + count, quantized + getPaddedCount(count), (int8_t) 0);
+}
+
+float QuantizedLayer::getScale(double maxAbs) {
+	return maxAbs > 0.0 ? (float) (maxAbs / 127.0) : 1.0f;
+}
+
+size_t QuantizedLayer::getPaddedCount(size_t count) {
+	return (count + Kernel::INT8_BLOCK - 1) / Kernel::INT8_BLOCK * Kernel::INT8_BLOCK;
+}
+
+unsigned int QuantizedLayer::getNeuralsCount() const {
+	return neuralsCount;
+}
+
+unsigned int QuantizedLayer::getInputsCount() const {
+	return inputsCount;
+}
+
+float QuantizedLayer::getInputScale() const {
+	return inputScale;
+}
+
+size_t QuantizedLayer::getWeightsBytes() const {
+	return weights.size() * sizeof(int8_t) + (rowSums.size() + scales.size() + biases.size()) * 4 + (rowOffsets.size() + columns.size()) * sizeof(unsigned int);
+}
+
+template QuantizedLayer::QuantizedLayer(const Layer<float>&, float, QuantizationType);
+template QuantizedLayer::QuantizedLayer(const Layer<double>&, float, QuantizationType);
+template void QuantizedLayer::quantize<float>(const float*, size_t, float, int8_t*);
+template void QuantizedLayer::quantize<double>(const double*, size_t, float, int8_t*);
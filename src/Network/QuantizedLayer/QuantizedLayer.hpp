@@ -0,0 +1,155 @@
+/*
+ * QuantizedLayer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef QUANTIZEDLAYER_QUANTIZEDLAYER_HPP_
+#define QUANTIZEDLAYER_QUANTIZEDLAYER_HPP_
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+#include "../../constant.h"
+
+#include "../Layer/Layer.hpp"
+
+/**
+ * Int8 representation of one layer of the network (inference only)
+ *
+ * Weights are quantized symmetrically (one scale by neural or one by layer), the input values
+ * are quantized with the scale measured on a calibration set. The int32 sums are dequantized,
+ * biased, excited and quantized again for the next layer in one pass. A sparse layer keeps
+ * its CSR links (int8 values, row offsets and columns)
+ */
+class QuantizedLayer {
+protected:
+	/**
+	 * Number of neurals
+	 */
+	unsigned int neuralsCount;
+
+	/**
+	 * Number of neurals of the previous layer
+	 */
+	unsigned int inputsCount;
+
+	/**
+	 * Row stride of the weights (inputsCount padded to a multiple of Kernel::INT8_BLOCK)
+	 */
+	size_t paddedInputsCount;
+
+	/**
+	 * Quantized weights matrix (neuralsCount x paddedInputsCount, padded with zeros)
+	 * or quantized links of a sparse layer (CSR order)
+	 */
+	std::vector<int8_t> weights;
+
+	/**
+	 * Sums of the quantized weights of each neural (neuralsCount, empty for a sparse layer)
+	 */
+	std::vector<int32_t> rowSums;
+
+	/**
+	 * First link of each neural (neuralsCount + 1, empty for a dense layer)
+	 */
+	std::vector<unsigned int> rowOffsets;
+
+	/**
+	 * Input of each link (empty for a dense layer)
+	 */
+	std::vector<unsigned int> columns;
+
+	/**
+	 * Dequantization scales: weights scale * input scale (neuralsCount)
+	 */
+	std::vector<float> scales;
+
+	/**
+	 * Biases (neuralsCount)
+	 */
+	std::vector<float> biases;
+
+	/**
+	 * Scale of the quantized input values
+	 */
+	float inputScale;
+
+	/**
+	 * Excitation type
+	 */
+	ExcitationType excitationType;
+
+public:
+	/**
+	 * Constructor
+	 * @param layer trained layer
+	 * @param inputScale scale of the input values (max |input| / 127)
+	 * @param qT quantization type of the weights
+	 * @throw invalid_argument if the layer is not a connected sum layer
+	 */
+	template<typename T>
+	QuantizedLayer(const Layer<T>& layer, float inputScale, QuantizationType qT);
+
+	/**
+	 * Compute forward propagation: f(scale * (Wq * previous) + b)
+	 * @param previous quantized output values of the previous layer (paddedInputsCount)
+	 * @param accumulators int32 sums (neuralsCount)
+	 * @param outputs output values of the neurals (neuralsCount)
+	 * @param quantizedOutputs quantized output values for the next layer (padded neuralsCount), can be null
+	 * @param outputScale scale of the quantized output values
+	 */
+	void forwardPropagation(const int8_t* previous, int32_t* accumulators, float* outputs, int8_t* quantizedOutputs, float outputScale) const;
+
+	/**
+	 * Quantize values: round(value / scale) in [-127, 127]
+	 * @param values values
+	 * @param count number of values
+	 * @param scale scale of the quantized values
+	 * @param quantized quantized values (padded count, the padding is set to zero)
+	 */
+	template<typename T>
+	static void quantize(const T* values, size_t count, float scale, int8_t* quantized);
+
+	/**
+	 * Get the scale of values of a max absolute value (max / 127, 1 for 0)
+	 * @param maxAbs max absolute value
+	 * @return scale
+	 */
+	static float getScale(double maxAbs);
+
+	/**
+	 * Get a count padded to a multiple of Kernel::INT8_BLOCK
+	 * @param count count
+	 * @return padded count
+	 */
+	static size_t getPaddedCount(size_t count);
+
+	/**
+	 * Get number of neurals
+	 * @return number of neurals
+	 */
+	unsigned int getNeuralsCount() const;
+
+	/**
+	 * Get number of neurals of the previous layer
+	 * @return number of inputs
+	 */
+	unsigned int getInputsCount() const;
+
+	/**
+	 * Get scale of the input values
+	 * @return input scale
+	 */
+	float getInputScale() const;
+
+	/**
+	 * Get size of the quantized weights, of their scales and of the sparse links indices
+	 * @return size in bytes
+	 */
+	size_t getWeightsBytes() const;
+};
+
+#endif /* QUANTIZEDLAYER_QUANTIZEDLAYER_HPP_ */
@@ -0,0 +1,203 @@
+/*
+ * QuantizedNetwork.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <cmath>
+
+#include "QuantizedNetwork.hpp"
+#include "../Scratch/Scratch.hpp"
+
+template<typename T>
+QuantizedNetwork<T>::QuantizedNetwork(const Network<T>& network, const Matrix<T>& calibrationInputs, QuantizationType qT) {
+	// Check if the network is ready
+	size_t layersCount = network.getLayersCount();
+	if (layersCount < 2 || network.getLayer(layersCount - 1).getType() != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("The network is not complete");
+	}
+
+	inputsCount = network.getLayer(0).getNeuralsCount();
+	outputsCount = network.getLayer(layersCount - 1).getNeuralsCount();
+
+	// Control input parameter: calibration set
+	if (calibrationInputs.getRowsCount() == 0) {
+		throw std::invalid_argument("The calibration set should not be empty");
+	}
+	if (calibrationInputs.getColsCount() < inputsCount) {
+		throw std::invalid_argument("The calibration matrix should have, at least, as many columns as the input layer");
+	}
+
+	// Max |value| of the outputs of each layer on the calibration set (by chunks of rows)
+	std::vector<double> maxAbs(layersCount, 0.0);
+	Scratch<T> scratch;
+	Matrix<T> chunk;
+	const size_t CHUNK_ROWS = 256;
+	for (size_t first = 0; first < calibrationInputs.getRowsCount(); first += CHUNK_ROWS) {
+		size_t count = std::min(CHUNK_ROWS, calibrationInputs.getRowsCount() - first);
+		chunk.resize(count, inputsCount);
+		for (size_t r = 0; r < count; ++r) {
+			std::copy(calibrationInputs.row(first + r), calibrationInputs.row(first + r) + inputsCount, chunk.row(r));
+		}
+
+		const Matrix<T>* previous = &chunk;
+		for (size_t i = 0; i < layersCount; ++i) {
+			if (i > 0) {
+				const Layer<T>& layer = network.getLayer(i);
+				Matrix<T>& inputs = scratch.getInputValues();
+				Matrix<T>& outputs = scratch.getOutputValues(i);
+				inputs.resize(count, layer.getNeuralsCount());
+				outputs.resize(count, layer.getNeuralsCount());
+				layer.forwardPropagation(*previous, inputs, outputs);
+				previous = &outputs;
+			}
+			const T* values = previous->data();
+			for (size_t j = 0; j < previous->getRowsCount() * previous->getColsCount(); ++j) {
+				maxAbs[i] = std::max(maxAbs[i], (double) std::fabs(values[j]));
+			}
+		}
+	}
+
+	// Quantize the layers, the input of a layer is the output of the previous one
+	maxPaddedCount = QuantizedLayer::getPaddedCount(inputsCount);
+	for (size_t i = 1; i < layersCount; ++i) {
+		layers.emplace_back(network.getLayer(i), QuantizedLayer::getScale(maxAbs[i - 1]), qT);
+		maxPaddedCount = std::max(maxPaddedCount, QuantizedLayer::getPaddedCount(network.getLayer(i).getNeuralsCount()));
+	}
+}
+
+template<typename T>
+const float* QuantizedNetwork<T>::propagate(const T* inputValues) const {
+	// Buffers of this thread
+	static thread_local std::vector<int8_t> quantizedValues[2];
+	static thread_local std::vector<int32_t> accumulators;
+	static thread_local std::vector<float> outputValues;
+	quantizedValues[0].resize(maxPaddedCount);
+	quantizedValues[1].resize(maxPaddedCount);
+	accumulators.resize(maxPaddedCount);
+	outputValues.resize(maxPaddedCount);
+
+	// Quantize the inputs and propagate (the last layer is not quantized again)
+	QuantizedLayer::quantize(inputValues, inputsCount, layers.front().getInputScale(), quantizedValues[0].data());
+	for (size_t i = 0; i < layers.size(); ++i) {
+		bool isLast = (i + 1 == layers.size());
+		int8_t* quantizedOutputs = isLast ? nullptr : quantizedValues[(i + 1) % 2].data();
+		float outputScale = isLast ? 1.0f : layers[i + 1].getInputScale();
+		layers[i].forwardPropagation(quantizedValues[i % 2].data(), accumulators.data(), outputValues.data(), quantizedOutputs, outputScale);
+	}
+	return outputValues.data();
+}
+
+template<typename T>
+template<typename U>
+int QuantizedNetwork<T>::getClassMax(const U* outputValues) const {
+	int maxClass = 0;
+	U maxClassValue = outputValues[0];
+
+	// For each output neurals, get the highest neural
+	for (unsigned int i = 1; i < outputsCount; ++i) {
+		if (outputValues[i] > maxClassValue) {
+			maxClass = i;
+			maxClassValue = outputValues[i];
+		}
+	}
+	return maxClass;
+}
+
+template<typename T>
+int QuantizedNetwork<T>::estimate(const std::vector<T>& inputValues) const {
+	// Control input parameter: input values
+	if (inputValues.size() < inputsCount) {
+		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
+	}
+
+	return getClassMax(propagate(inputValues.data()));
+}
+
+template<typename T>
+int QuantizedNetwork<T>::estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues) const {
+	// Control input parameter: input values
+	if (inputValues.size() < inputsCount) {
+		throw std::invalid_argument("The input values vector should be, at least, equals to input layer");
+	}
+
+	// Copy the output values and return max class
+	const float* outputs = propagate(inputValues.data());
+	outputValues.assign(outputs, outputs + outputsCount);
+	return getClassMax(outputs);
+}
+
+template<typename T>
+void QuantizedNetwork<T>::estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues) const {
+	// Control input parameter: input values
+	if (inputValues.getColsCount() < inputsCount) {
+		throw std::invalid_argument("The input values matrix should have, at least, as many columns as the input layer");
+	}
+
+	outputValues.resize(inputValues.getRowsCount(), outputsCount);
+	for (size_t r = 0; r < inputValues.getRowsCount(); ++r) {
+		const float* outputs = propagate(inputValues.row(r));
+		std::copy(outputs, outputs + outputsCount, outputValues.row(r));
+	}
+}
+
+template<typename T>
+QuantizationReport QuantizedNetwork<T>::compare(const Network<T>& network, const Matrix<T>& inputValues, const std::vector<unsigned int>& expectedClasses) const {
+	// Control input parameter: expected classes
+	size_t samplesCount = inputValues.getRowsCount();
+	if (expectedClasses.size() != samplesCount) {
+		throw std::invalid_argument("The expected classes vector should have as many values as the input values matrix rows");
+	}
+
+	// Estimations of both networks
+	Matrix<T> outputs;
+	Matrix<T> quantizedOutputs;
+	network.estimateBatch(inputValues, outputs);
+	estimateBatch(inputValues, quantizedOutputs);
+
+	QuantizationReport report = QuantizationReport();
+	report.samplesCount = samplesCount;
+	size_t correct = 0;
+	size_t quantizedCorrect = 0;
+	size_t agreements = 0;
+	for (size_t r = 0; r < samplesCount; ++r) {
+		int c = getClassMax(outputs.row(r));
+		int qc = getClassMax(quantizedOutputs.row(r));
+		correct += ((unsigned int) c == expectedClasses[r]);
+		quantizedCorrect += ((unsigned int) qc == expectedClasses[r]);
+		agreements += (c == qc);
+		for (size_t j = 0; j < outputsCount; ++j) {
+			report.maxOutputError = std::max(report.maxOutputError, (double) std::fabs(outputs.at(r, j) - quantizedOutputs.at(r, j)));
+		}
+	}
+	if (samplesCount > 0) {
+		report.accuracy = correct / (double) samplesCount;
+		report.quantizedAccuracy = quantizedCorrect / (double) samplesCount;
+		report.agreement = agreements / (double) samplesCount;
+	}
+	report.accuracyDrop = report.accuracy - report.quantizedAccuracy;
+
+	// Footprint of the weights
+	for (size_t i = 1; i < network.getLayersCount(); ++i) {
+		const Layer<T>& layer = network.getLayer(i);
+		report.weightsBytes += (layer.getLinksCount() + layer.getNeuralsCount()) * sizeof(T);
+		report.weightsBytes += (layer.getRowOffsets().size() + layer.getColumns().size()) * sizeof(unsigned int);
+	}
+	report.quantizedWeightsBytes = getWeightsBytes();
+	return report;
+}
+
+template<typename T>
+size_t QuantizedNetwork<T>::getWeightsBytes() const {
+	size_t bytes = 0;
+	for (const QuantizedLayer& layer : layers) {
+		bytes += layer.getWeightsBytes();
+	}
+	return bytes;
+}
+
+template class QuantizedNetwork<float>;
+template class QuantizedNetwork<double>;
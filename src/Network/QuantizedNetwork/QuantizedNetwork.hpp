@@ -0,0 +1,163 @@
+/*
+ * QuantizedNetwork.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef QUANTIZEDNETWORK_QUANTIZEDNETWORK_HPP_
+#define QUANTIZEDNETWORK_QUANTIZEDNETWORK_HPP_
+
+#include <vector>
+#include <cstdint>
+
+#include "../../constant.h"
+
+#include "../Network.hpp"
+#include "../Matrix/Matrix.hpp"
+#include "../QuantizedLayer/QuantizedLayer.hpp"
+
+/**
+ * Comparison of a quantized network with its source network
+ */
+struct QuantizationReport {
+	/**
+	 * Number of compared samples
+	 */
+	size_t samplesCount;
+
+	/**
+	 * Accuracy of the source network (ratio of estimations equal to the expected class)
+	 */
+	double accuracy;
+
+	/**
+	 * Accuracy of the quantized network
+	 */
+	double quantizedAccuracy;
+
+	/**
+	 * Accuracy drop (accuracy - quantizedAccuracy)
+	 */
+	double accuracyDrop;
+
+	/**
+	 * Ratio of samples with the same estimation in both networks
+	 */
+	double agreement;
+
+	/**
+	 * Max absolute difference of the output values
+	 */
+	double maxOutputError;
+
+	/**
+	 * Size of the weights of the source network in bytes (with the indices of the sparse links)
+	 */
+	size_t weightsBytes;
+
+	/**
+	 * Size of the weights of the quantized network in bytes (with the indices of the sparse links)
+	 */
+	size_t quantizedWeightsBytes;
+};
+
+/**
+ * Int8 inference model converted from a trained network (post-training quantization)
+ *
+ * The scales of the values of each layer are the max absolute values measured by propagating
+ * a calibration set in the source network
+ */
+template<typename T>
+class QuantizedNetwork {
+protected:
+	/**
+	 * Number of input neurals
+	 */
+	unsigned int inputsCount;
+
+	/**
+	 * Number of output neurals
+	 */
+	unsigned int outputsCount;
+
+	/**
+	 * Quantized layers (without the input layer)
+	 */
+	std::vector<QuantizedLayer> layers;
+
+	/**
+	 * Padded number of neurals of the widest layer
+	 */
+	size_t maxPaddedCount;
+
+protected:
+	/**
+	 * Compute forward propagation of one sample (buffers are local to the thread)
+	 * @param inputValues input values
+	 * @return output values of the last layer
+	 */
+	const float* propagate(const T* inputValues) const;
+
+	/**
+	 * Get class max
+	 * @param outputValues output values of the last layer
+	 * @return max class
+	 */
+	template<typename U>
+	int getClassMax(const U* outputValues) const;
+
+public:
+	/**
+	 * Constructor: quantize the network and calibrate the scales of the values
+	 * @param network trained network
+	 * @param calibrationInputs input values of the calibration set (one row by sample)
+	 * @param qT quantization type of the weights
+	 * @throw logic_error if the network is not complete
+	 * @throw invalid_argument if the calibration set is empty or its bounds are not correct
+	 */
+	QuantizedNetwork(const Network<T>& network, const Matrix<T>& calibrationInputs, QuantizationType qT = QuantizationType::PER_ROW);
+
+	/**
+	 * Compute estimation (reentrant: buffers are local to the thread)
+	 * @param inputValues input values
+	 * @return the max class
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int estimate(const std::vector<T>& inputValues) const;
+
+	/**
+	 * Compute estimation (reentrant: buffers are local to the thread)
+	 * @param inputValues input values
+	 * @param outputValues output values of the last layer
+	 * @return the max class
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	int estimate(const std::vector<T>& inputValues, std::vector<T>& outputValues) const;
+
+	/**
+	 * Compute estimation of a batch of samples
+	 * @param inputValues input values (one row by sample)
+	 * @param outputValues output values of the last layer (one row by sample)
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	void estimateBatch(const Matrix<T>& inputValues, Matrix<T>& outputValues) const;
+
+	/**
+	 * Compare the estimations with the ones of the source network
+	 * @param network source network
+	 * @param inputValues input values (one row by sample)
+	 * @param expectedClasses expected class of each sample
+	 * @return comparison of the two networks
+	 * @throw invalid_argument if bounds are not correct
+	 */
+	QuantizationReport compare(const Network<T>& network, const Matrix<T>& inputValues, const std::vector<unsigned int>& expectedClasses) const;
+
+	/**
+	 * Get size of the quantized weights
+	 * @return size in bytes
+	 */
+	size_t getWeightsBytes() const;
+};
+
+#endif /* QUANTIZEDNETWORK_QUANTIZEDNETWORK_HPP_ */
@@ -0,0 +1,24 @@
+/*
+ * Scratch.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include "Scratch.hpp"
+
+template<typename T>
+Scratch<T>::Scratch() {}
+
+template<typename T>
+Matrix<T>& Scratch<T>::getInputValues() {
+	return inputValues;
+}
+
+template<typename T>
+Matrix<T>& Scratch<T>::getOutputValues(size_t layer) {
+	return outputValues[layer % 2];
+}
+
+template class Scratch<float>;
+template class Scratch<double>;
@@ -0,0 +1,54 @@
+/*
+ * Scratch.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef SCRATCH_SCRATCH_HPP_
+#define SCRATCH_SCRATCH_HPP_
+
+#include <cstddef>
+
+#include "../Matrix/Matrix.hpp"
+
+/**
+ * Working buffers of inference (owned by the caller, one by thread)
+ *
+ * Only the values of two consecutive layers are needed, the output buffers are used in turn.
+ * The buffers hold one row by sample (one row for a single estimation)
+ */
+template<typename T>
+class Scratch {
+protected:
+	/**
+	 * Neurals input values of the current layer
+	 */
+	Matrix<T> inputValues;
+
+	/**
+	 * Neurals output values of two consecutive layers
+	 */
+	Matrix<T> outputValues[2];
+
+public:
+	/**
+	 * Constructor
+	 */
+	Scratch();
+
+	/**
+	 * Get input values buffer
+	 * @return input values
+	 */
+	Matrix<T>& getInputValues();
+
+	/**
+	 * Get output values buffer of a layer
+	 * @param layer layer index
+	 * @return output values
+	 */
+	Matrix<T>& getOutputValues(size_t layer);
+};
+
+#endif /* SCRATCH_SCRATCH_HPP_ */
@@ -0,0 +1,366 @@
+/*
+ * Simd.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef SIMD_SIMD_HPP_
+#define SIMD_SIMD_HPP_
+
+/**
+ * SIMD helpers shared by the kernels
+ *
+ * The instruction set is chosen at compile time (/arch:AVX2 or /arch:AVX512 with MSVC,
+ * -mavx2 -mfma or -mavx512f with GCC/Clang), every kernel keeps a scalar path
+ */
+
+#include <cstddef>
+#include <cmath>
+
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__AVX512F__)
+#define ANN_SIMD_AVX512 1
+#endif
+
+#if defined(__AVX2__)
+#define ANN_SIMD_AVX2 1
+#endif
+
+namespace Simd {
+
+	// Bounds of the exponential argument (2^n stays a normal number)
+	const double EXP_MAX = 708.0;
+	const double EXP_MIN = -708.0;
+
+	// Coefficients of the Taylor series of exp on [-ln(2) / 2, ln(2) / 2]
+	const double EXP_C2 = 1.0 / 2.0;
+	const double EXP_C3 = 1.0 / 6.0;
+	const double EXP_C4 = 1.0 / 24.0;
+	const double EXP_C5 = 1.0 / 120.0;
+	const double EXP_C6 = 1.0 / 720.0;
+	const double EXP_C7 = 1.0 / 5040.0;
+	const double EXP_C8 = 1.0 / 40320.0;
+	const double EXP_C9 = 1.0 / 362880.0;
+	const double EXP_C10 = 1.0 / 3628800.0;
+	const double EXP_C11 = 1.0 / 39916800.0;
+	const double EXP_C12 = 1.0 / 479001600.0;
+
+	// log2(e) and ln(2) split in high and low parts (Cody-Waite reduction)
+	const double LOG2E = 1.4426950408889634;
+	const double LN2_HI = 6.93145751953125e-1;
+	const double LN2_LO = 1.42860682030941723212e-6;
+
+	// Bounds of the exponential argument in single precision
+	const float EXPF_MAX = 88.0f;
+	const float EXPF_MIN = -87.0f;
+
+	// ln(2) split in high and low parts in single precision
+	const float LN2F_HI = 0.693359375f;
+	const float LN2F_LO = -2.12194440e-4f;
+
+#if defined(ANN_SIMD_AVX2)
+	inline __m256d fmadd(__m256d a, __m256d b, __m256d c) {
+#if defined(__FMA__) || defined(_MSC_VER)
+		return _mm256_fmadd_pd(a, b, c);
+#else
+		return _mm256_add_pd(_mm256_mul_pd(a, b), c);
+#endif
+	}
+
+	/**
+	 * Exponential of four doubles
+	 * @param x values (clamped to [EXP_MIN, EXP_MAX])
+	 * @return exp(x)
+	 */
+	inline __m256d exp(__m256d x) {
+		x = _mm256_min_pd(_mm256_max_pd(x, _mm256_set1_pd(EXP_MIN)), _mm256_set1_pd(EXP_MAX));
+
+		// x = n * ln(2) + r
+		__m256d n = _mm256_round_pd(_mm256_mul_pd(x, _mm256_set1_pd(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256d r = fmadd(n, _mm256_set1_pd(-LN2_HI), x);
+		r = fmadd(n, _mm256_set1_pd(-LN2_LO), r);
+
+		// exp(r) (Horner)
+		__m256d p = _mm256_set1_pd(EXP_C12);
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C11));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C10));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C9));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C8));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C7));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C6));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C5));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C4));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C3));
+		p = fmadd(p, r, _mm256_set1_pd(EXP_C2));
+		p = fmadd(p, r, _mm256_set1_pd(1.0));
+		p = fmadd(p, r, _mm256_set1_pd(1.0));
+
+		// 2^n: (n + 1023) in the exponent bits
+		__m256i e = _mm256_castpd_si256(_mm256_add_pd(n, _mm256_set1_pd(1023.0 + 4503599627370496.0)));
+		e = _mm256_slli_epi64(e, 52);
+		return _mm256_mul_pd(p, _mm256_castsi256_pd(e));
+	}
+
+	inline __m256 fmadd(__m256 a, __m256 b, __m256 c) {
+#if defined(__FMA__) || defined(_MSC_VER)
+		return _mm256_fmadd_ps(a, b, c);
+#else
+		return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+	}
+
+	/**
+	 * Exponential of eight floats (Taylor series up to r^7, enough in single precision)
+	 * @param x values (clamped to [EXPF_MIN, EXPF_MAX])
+	 * @return exp(x)
+	 */
+	inline __m256 exp(__m256 x) {
+		x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(EXPF_MIN)), _mm256_set1_ps(EXPF_MAX));
+
+		// x = n * ln(2) + r
+		__m256 n = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps((float) LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m256 r = fmadd(n, _mm256_set1_ps(-LN2F_HI), x);
+		r = fmadd(n, _mm256_set1_ps(-LN2F_LO), r);
+
+		// exp(r) (Horner)
+		__m256 p = _mm256_set1_ps((float) EXP_C7);
+		p = fmadd(p, r, _mm256_set1_ps((float) EXP_C6));
+		p = fmadd(p, r, _mm256_set1_ps((float) EXP_C5));
+		p = fmadd(p, r, _mm256_set1_ps((float) EXP_C4));
+		p = fmadd(p, r, _mm256_set1_ps((float) EXP_C3));
+		p = fmadd(p, r, _mm256_set1_ps((float) EXP_C2));
+		p = fmadd(p, r, _mm256_set1_ps(1.0f));
+		p = fmadd(p, r, _mm256_set1_ps(1.0f));
+
+		// 2^n: (n + 127) in the exponent bits
+		__m256i e = _mm256_add_epi32(_mm256_cvtps_epi32(n), _mm256_set1_epi32(127));
+		e = _mm256_slli_epi32(e, 23);
+		return _mm256_mul_ps(p, _mm256_castsi256_ps(e));
+	}
+#endif
+
+#if defined(ANN_SIMD_AVX512)
+	/**
+	 * Exponential of eight doubles
+	 * @param x values (clamped to [EXP_MIN, EXP_MAX])
+	 * @return exp(x)
+	 */
+	inline __m512d exp(__m512d x) {
+		x = _mm512_min_pd(_mm512_max_pd(x, _mm512_set1_pd(EXP_MIN)), _mm512_set1_pd(EXP_MAX));
+
+		// x = n * ln(2) + r
+		__m512d n = _mm512_roundscale_pd(_mm512_mul_pd(x, _mm512_set1_pd(LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m512d r = _mm512_fmadd_pd(n, _mm512_set1_pd(-LN2_HI), x);
+		r = _mm512_fmadd_pd(n, _mm512_set1_pd(-LN2_LO), r);
+
+		// exp(r) (Horner)
+		__m512d p = _mm512_set1_pd(EXP_C12);
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C11));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C10));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C9));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C8));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C7));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C6));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C5));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C4));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C3));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(EXP_C2));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+		p = _mm512_fmadd_pd(p, r, _mm512_set1_pd(1.0));
+
+		// 2^n
+		return _mm512_scalef_pd(p, n);
+	}
+
+	/**
+	 * Exponential of sixteen floats (Taylor series up to r^7, enough in single precision)
+	 * @param x values (clamped to [EXPF_MIN, EXPF_MAX])
+	 * @return exp(x)
+	 */
+	inline __m512 exp(__m512 x) {
+		x = _mm512_min_ps(_mm512_max_ps(x, _mm512_set1_ps(EXPF_MIN)), _mm512_set1_ps(EXPF_MAX));
+
+		// x = n * ln(2) + r
+		__m512 n = _mm512_roundscale_ps(_mm512_mul_ps(x, _mm512_set1_ps((float) LOG2E)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+		__m512 r = _mm512_fmadd_ps(n, _mm512_set1_ps(-LN2F_HI), x);
+		r = _mm512_fmadd_ps(n, _mm512_set1_ps(-LN2F_LO), r);
+
+		// exp(r) (Horner)
+		__m512 p = _mm512_set1_ps((float) EXP_C7);
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps((float) EXP_C6));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps((float) EXP_C5));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps((float) EXP_C4));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps((float) EXP_C3));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps((float) EXP_C2));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0f));
+		p = _mm512_fmadd_ps(p, r, _mm512_set1_ps(1.0f));
+
+		// 2^n
+		return _mm512_scalef_ps(p, n);
+	}
+#endif
+
+	/**
+	 * Vector of the widest instruction set available for a scalar type
+	 * (width = 1 and plain scalar operations without SIMD)
+	 *
+	 * copySign(a, b) expects a positive a, selectLess(a, b, x, y) is a < b ? x : y
+	 * and gather(p, indexes) loads p[indexes[0]], ..., p[indexes[width - 1]]
+	 */
+	template<typename T>
+	struct Vec;
+
+#if defined(ANN_SIMD_AVX512)
+	template<>
+	struct Vec<double> {
+		typedef __m512d type;
+		static const size_t width = 8;
+		static type zero() { return _mm512_setzero_pd(); }
+		static type set1(double v) { return _mm512_set1_pd(v); }
+		static type load(const double* p) { return _mm512_loadu_pd(p); }
+		static type gather(const double* p, const unsigned int* indexes) { return _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, _mm256_loadu_si256((const __m256i*) indexes), p, 8); }
+		static void store(double* p, type v) { _mm512_storeu_pd(p, v); }
+		static type add(type a, type b) { return _mm512_add_pd(a, b); }
+		static type mul(type a, type b) { return _mm512_mul_pd(a, b); }
+		static type fmadd(type a, type b, type c) { return _mm512_fmadd_pd(a, b, c); }
+		static double sum(type v) { return _mm512_reduce_add_pd(v); }
+		static type max(type a, type b) { return _mm512_max_pd(a, b); }
+		static double reduceMax(type v) { return _mm512_reduce_max_pd(v); }
+		static type sub(type a, type b) { return _mm512_sub_pd(a, b); }
+		static type div(type a, type b) { return _mm512_div_pd(a, b); }
+		static type exp(type a) { return Simd::exp(a); }
+		static type sqrt(type a) { return _mm512_sqrt_pd(a); }
+		static type abs(type a) { return _mm512_abs_pd(a); }
+		static type copySign(type a, type b) {
+			__m512i sign = _mm512_and_si512(_mm512_castpd_si512(b), _mm512_set1_epi64((long long) 0x8000000000000000ULL));
+			return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(a), sign));
+		}
+		static type selectLess(type a, type b, type x, type y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_LT_OQ), y, x); }
+		static type selectNotEqual(type a, type b, type x, type y) { return _mm512_mask_blend_pd(_mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ), y, x); }
+	};
+
+	template<>
+	struct Vec<float> {
+		typedef __m512 type;
+		static const size_t width = 16;
+		static type zero() { return _mm512_setzero_ps(); }
+		static type set1(float v) { return _mm512_set1_ps(v); }
+		static type load(const float* p) { return _mm512_loadu_ps(p); }
+		static type gather(const float* p, const unsigned int* indexes) { return _mm512_mask_i32gather_ps(_mm512_setzero_ps(), 0xFFFF, _mm512_loadu_si512(indexes), p, 4); }
+		static void store(float* p, type v) { _mm512_storeu_ps(p, v); }
+		static type add(type a, type b) { return _mm512_add_ps(a, b); }
+		static type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+		static type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+		static float sum(type v) { return _mm512_reduce_add_ps(v); }
+		static type max(type a, type b) { return _mm512_max_ps(a, b); }
+		static float reduceMax(type v) { return _mm512_reduce_max_ps(v); }
+		static type sub(type a, type b) { return _mm512_sub_ps(a, b); }
+		static type div(type a, type b) { return _mm512_div_ps(a, b); }
+		static type exp(type a) { return Simd::exp(a); }
+		static type sqrt(type a) { return _mm512_sqrt_ps(a); }
+		static type abs(type a) { return _mm512_abs_ps(a); }
+		static type copySign(type a, type b) {
+			__m512i sign = _mm512_and_si512(_mm512_castps_si512(b), _mm512_set1_epi32((int) 0x80000000U));
+			return _mm512_castsi512_ps(_mm512_or_si512(_mm512_castps_si512(a), sign));
+		}
+		static type selectLess(type a, type b, type x, type y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_LT_OQ), y, x); }
+		static type selectNotEqual(type a, type b, type x, type y) { return _mm512_mask_blend_ps(_mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ), y, x); }
+	};
+#elif defined(ANN_SIMD_AVX2)
+	template<>
+	struct Vec<double> {
+		typedef __m256d type;
+		static const size_t width = 4;
+		static type zero() { return _mm256_setzero_pd(); }
+		static type set1(double v) { return _mm256_set1_pd(v); }
+		static type load(const double* p) { return _mm256_loadu_pd(p); }
+		static type gather(const double* p, const unsigned int* indexes) { return _mm256_mask_i32gather_pd(_mm256_setzero_pd(), p, _mm_loadu_si128((const __m128i*) indexes), _mm256_castsi256_pd(_mm256_set1_epi64x(-1)), 8); }
+		static void store(double* p, type v) { _mm256_storeu_pd(p, v); }
+		static type add(type a, type b) { return _mm256_add_pd(a, b); }
+		static type mul(type a, type b) { return _mm256_mul_pd(a, b); }
+		static type fmadd(type a, type b, type c) { return Simd::fmadd(a, b, c); }
+		static double sum(type v) {
+			__m128d h = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+			return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+		}
+		static type max(type a, type b) { return _mm256_max_pd(a, b); }
+		static double reduceMax(type v) {
+			__m128d h = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+			return _mm_cvtsd_f64(_mm_max_sd(h, _mm_unpackhi_pd(h, h)));
+		}
+		static type sub(type a, type b) { return _mm256_sub_pd(a, b); }
+		static type div(type a, type b) { return _mm256_div_pd(a, b); }
+		static type exp(type a) { return Simd::exp(a); }
+		static type sqrt(type a) { return _mm256_sqrt_pd(a); }
+		static type abs(type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+		static type copySign(type a, type b) { return _mm256_or_pd(a, _mm256_and_pd(b, _mm256_set1_pd(-0.0))); }
+		static type selectLess(type a, type b, type x, type y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_LT_OQ)); }
+		static type selectNotEqual(type a, type b, type x, type y) { return _mm256_blendv_pd(y, x, _mm256_cmp_pd(a, b, _CMP_NEQ_UQ)); }
+	};
+
+	template<>
+	struct Vec<float> {
+		typedef __m256 type;
+		static const size_t width = 8;
+		static type zero() { return _mm256_setzero_ps(); }
+		static type set1(float v) { return _mm256_set1_ps(v); }
+		static type load(const float* p) { return _mm256_loadu_ps(p); }
+		static type gather(const float* p, const unsigned int* indexes) { return _mm256_mask_i32gather_ps(_mm256_setzero_ps(), p, _mm256_loadu_si256((const __m256i*) indexes), _mm256_castsi256_ps(_mm256_set1_epi32(-1)), 4); }
+		static void store(float* p, type v) { _mm256_storeu_ps(p, v); }
+		static type add(type a, type b) { return _mm256_add_ps(a, b); }
+		static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+		static type fmadd(type a, type b, type c) { return Simd::fmadd(a, b, c); }
+		static float sum(type v) {
+			__m128 h = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+			h = _mm_add_ps(h, _mm_movehl_ps(h, h));
+			return _mm_cvtss_f32(_mm_add_ss(h, _mm_shuffle_ps(h, h, 1)));
+		}
+		static type max(type a, type b) { return _mm256_max_ps(a, b); }
+		static float reduceMax(type v) {
+			__m128 h = _mm_max_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+			h = _mm_max_ps(h, _mm_movehl_ps(h, h));
+			return _mm_cvtss_f32(_mm_max_ss(h, _mm_shuffle_ps(h, h, 1)));
+		}
+		static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+		static type div(type a, type b) { return _mm256_div_ps(a, b); }
+		static type exp(type a) { return Simd::exp(a); }
+		static type sqrt(type a) { return _mm256_sqrt_ps(a); }
+		static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+		static type copySign(type a, type b) { return _mm256_or_ps(a, _mm256_and_ps(b, _mm256_set1_ps(-0.0f))); }
+		static type selectLess(type a, type b, type x, type y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_LT_OQ)); }
+		static type selectNotEqual(type a, type b, type x, type y) { return _mm256_blendv_ps(y, x, _mm256_cmp_ps(a, b, _CMP_NEQ_UQ)); }
+	};
+#else
+	template<typename T>
+	struct Vec {
+		typedef T type;
+		static const size_t width = 1;
+		static type zero() { return T(0); }
+		static type set1(T v) { return v; }
+		static type load(const T* p) { return *p; }
+		static type gather(const T* p, const unsigned int* indexes) { return p[*indexes]; }
+		static void store(T* p, type v) { *p = v; }
+		static type add(type a, type b) { return a + b; }
+		static type mul(type a, type b) { return a * b; }
+		static type fmadd(type a, type b, type c) { return a * b + c; }
+		static T sum(type v) { return v; }
+		static type max(type a, type b) { return a < b ? b : a; }
+		static T reduceMax(type v) { return v; }
+		static type sub(type a, type b) { return a - b; }
+		static type div(type a, type b) { return a / b; }
+		static type exp(type a) { return std::exp(a); }
+		static type sqrt(type a) { return std::sqrt(a); }
+		static type abs(type a) { return std::fabs(a); }
+		static type copySign(type a, type b) { return std::copysign(a, b); }
+		static type selectLess(type a, type b, type x, type y) { return a < b ? x : y; }
+		static type selectNotEqual(type a, type b, type x, type y) { return a != b ? x : y; }
+	};
+#endif
+
+}
+
+#endif /* SIMD_SIMD_HPP_ */
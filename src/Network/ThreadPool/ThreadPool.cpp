@@ -0,0 +1,218 @@
+/*
+ * ThreadPool.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <limits>
+
+#include "ThreadPool.hpp"
+
+namespace {
+
+	/**
+	 * Pool of the task run by this thread (a run from a task does not wait for the pool)
+	 */
+	thread_local const ThreadPool* currentPool = nullptr;
+
+}
+
+ThreadPool::ThreadPool(unsigned int threadsCount) {
+	task = nullptr;
+	pendingWorkers = 0;
+	generation = 0;
+	stopping = false;
+
+	// One thread by core by default
+	if (threadsCount == 0) {
+		threadsCount = std::thread::hardware_concurrency();
+		if (threadsCount == 0) {
+			threadsCount = 1;
+		}
+	}
+
+	// The calling thread is the last one
+	ranges.reset(new TaskRange[threadsCount]);
+	for (unsigned int i = 0; i < threadsCount; ++i) {
+		ranges[i].tasks = 0;
+	}
+	for (unsigned int i = 1; i < threadsCount; ++i) {
+		workers.emplace_back(&ThreadPool::work, this, i - 1);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	startCondition.notify_all();
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+unsigned int ThreadPool::getThreadsCount() const {
+	return (unsigned int)workers.size() + 1;
+}
+
+void ThreadPool::work(size_t thread) {
+	unsigned long lastGeneration = 0;
+	while (true) {
+		// Wait for a new generation of tasks
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			startCondition.wait(lock, [&] { return stopping || generation != lastGeneration; });
+			if (stopping) {
+				return;
+			}
+			lastGeneration = generation;
+		}
+
+		runTasks(thread);
+
+		// Signal the end of this worker
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--pendingWorkers == 0) {
+				doneCondition.notify_one();
+			}
+		}
+	}
+}
+
+bool ThreadPool::takeFirst(size_t thread, size_t& task) {
+	std::atomic<uint64_t>& tasks = ranges[thread].tasks;
+	uint64_t range = tasks.load();
+	do {
+		uint64_t first = range >> 32;
+		if (first >= (range & 0xFFFFFFFF)) {
+			return false;
+		}
+		task = (size_t) first;
+	} while (!tasks.compare_exchange_weak(range, range + ((uint64_t) 1 << 32)));
+	return true;
+}
+
+bool ThreadPool::takeLast(size_t thread, size_t& task) {
+	std::atomic<uint64_t>& tasks = ranges[thread].tasks;
+	uint64_t range = tasks.load();
+	do {
+		uint64_t last = range & 0xFFFFFFFF;
+		if ((range >> 32) >= last) {
+			return false;
+		}
+		task = (size_t) last - 1;
+	} while (!tasks.compare_exchange_weak(range, range - 1));
+	return true;
+}
+
+void ThreadPool::runTasks(size_t thread) {
+	const ThreadPool* previousPool = currentPool;
+	currentPool = this;
+
+	// Own tasks from the front, then the last tasks of the other threads (the ranges only
+	// shrink: a round without any task means that every task is taken)
+	size_t threadsCount = workers.size() + 1;
+	size_t i;
+	bool isTaken = true;
+	while (isTaken) {
+		isTaken = false;
+		for (size_t t = 0; t < threadsCount && !isTaken; ++t) {
+			size_t victim = (thread + t) % threadsCount;
+			isTaken = (victim == thread) ? takeFirst(victim, i) : takeLast(victim, i);
+		}
+		if (isTaken) {
+			try {
+				(*task)(i);
+			} catch (...) {
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+		}
+	}
+
+	currentPool = previousPool;
+}
+
+void ThreadPool::run(size_t tasksCount, const std::function<void(size_t)>& task) {
+	// Without workers, with one task or from a task of this pool there is nothing to share
+	if (workers.empty() || tasksCount == 1 || currentPool == this) {
+		runInline(tasksCount, task);
+		return;
+	}
+
+	// Control input parameter: tasks count (indexes of the ranges)
+	if (tasksCount > std::numeric_limits<uint32_t>::max()) {
+		throw std::invalid_argument("The number of tasks should be lower than 2^32");
+	}
+
+	std::lock_guard<std::mutex> runLock(runMutex);
+	runGeneration(tasksCount, task);
+}
+
+bool ThreadPool::tryRun(size_t tasksCount, const std::function<void(size_t)>& task) {
+	// Without workers, with one task or from a task of this pool there is nothing to share
+	if (workers.empty() || tasksCount == 1 || currentPool == this) {
+		runInline(tasksCount, task);
+		return false;
+	}
+
+	// Control input parameter: tasks count (indexes of the ranges)
+	if (tasksCount > std::numeric_limits<uint32_t>::max()) {
+		throw std::invalid_argument("The number of tasks should be lower than 2^32");
+	}
+
+	// Pool busy with another run: no wait
+	std::unique_lock<std::mutex> runLock(runMutex, std::try_to_lock);
+	if (!runLock.owns_lock()) {
+		runInline(tasksCount, task);
+		return false;
+	}
+	runGeneration(tasksCount, task);
+	return true;
+}
+
+void ThreadPool::runInline(size_t tasksCount, const std::function<void(size_t)>& task) {
+	for (size_t i = 0; i < tasksCount; ++i) {
+		task(i);
+	}
+}
+
+void ThreadPool::runGeneration(size_t tasksCount, const std::function<void(size_t)>& task) {
+	// Start a new generation: one contiguous range of tasks by thread
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		this->task = &task;
+		size_t threadsCount = workers.size() + 1;
+		for (size_t t = 0; t < threadsCount; ++t) {
+			uint64_t first = t * tasksCount / threadsCount;
+			uint64_t last = (t + 1) * tasksCount / threadsCount;
+			ranges[t].tasks = (first << 32) | last;
+		}
+		pendingWorkers = workers.size();
+		error = nullptr;
+		++generation;
+	}
+	startCondition.notify_all();
+
+	// The calling thread takes part
+	runTasks(workers.size());
+
+	// Wait for the workers
+	std::exception_ptr taskError;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		doneCondition.wait(lock, [&] { return pendingWorkers == 0; });
+		this->task = nullptr;
+		taskError = error;
+		error = nullptr;
+	}
+	if (taskError) {
+		std::rethrow_exception(taskError);
+	}
+}
@@ -0,0 +1,184 @@
+/*
+ * ThreadPool.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef THREADPOOL_THREADPOOL_HPP_
+#define THREADPOOL_THREADPOOL_HPP_
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <cstdint>
+
+/**
+ * Fixed pool of threads running indexed tasks synchronously (the calling thread takes part)
+ *
+ * The tasks are scheduled by work stealing: each thread starts with its own contiguous range
+ * of tasks (the same one from a run to the next with the same number of tasks: a thread
+ * finds the data of its tasks in its cache), takes them from the front, then steals the last
+ * tasks of the other threads when its range is empty. A run returns when every task is done:
+ * it is a barrier between two phases (the layers of a network)
+ */
+class ThreadPool {
+protected:
+	/**
+	 * Tasks not yet taken by a thread: first task in the high half, end in the low half
+	 * (changed at once, one cache line by thread)
+	 */
+	struct TaskRange {
+		std::atomic<uint64_t> tasks;
+		char padding[64 - sizeof(std::atomic<uint64_t>)];
+	};
+
+	/**
+	 * Worker threads (threadsCount - 1, the calling thread is the last one)
+	 */
+	std::vector<std::thread> workers;
+
+	/**
+	 * Protect the state shared with the workers
+	 */
+	std::mutex mutex;
+
+	/**
+	 * Serialize the calls of run
+	 */
+	std::mutex runMutex;
+
+	/**
+	 * Signal a new generation of tasks (or the stop)
+	 */
+	std::condition_variable startCondition;
+
+	/**
+	 * Signal the end of the workers
+	 */
+	std::condition_variable doneCondition;
+
+	/**
+	 * Current task
+	 */
+	const std::function<void(size_t)>* task;
+
+	/**
+	 * Tasks of each thread (the calling thread is the last one)
+	 */
+	std::unique_ptr<TaskRange[]> ranges;
+
+	/**
+	 * Number of workers still running the current generation
+	 */
+	size_t pendingWorkers;
+
+	/**
+	 * Generation of tasks (incremented by each run)
+	 */
+	unsigned long generation;
+
+	/**
+	 * First exception thrown by a task
+	 */
+	std::exception_ptr error;
+
+	/**
+	 * Workers have to stop
+	 */
+	bool stopping;
+
+protected:
+	/**
+	 * Loop of a worker thread
+	 * @param thread index of the thread
+	 */
+	void work(size_t thread);
+
+	/**
+	 * Run the tasks of a thread, then the ones stolen from the others until there is no more task
+	 * @param thread index of the thread
+	 */
+	void runTasks(size_t thread);
+
+	/**
+	 * Take the first task of a range
+	 * @param thread index of the thread of the range
+	 * @param task taken task
+	 * @return false if the range is empty
+	 */
+	bool takeFirst(size_t thread, size_t& task);
+
+	/**
+	 * Take the last task of a range
+	 * @param thread index of the thread of the range
+	 * @param task taken task
+	 * @return false if the range is empty
+	 */
+	bool takeLast(size_t thread, size_t& task);
+
+	/**
+	 * Run the tasks one after the other on the calling thread
+	 * @param tasksCount number of tasks
+	 * @param task task to run with the index of the task
+	 */
+	void runInline(size_t tasksCount, const std::function<void(size_t)>& task);
+
+	/**
+	 * Run the tasks on the threads and wait for the end of all of them (runMutex is locked)
+	 * @param tasksCount number of tasks
+	 * @param task task to run with the index of the task
+	 * @throw the first exception thrown by a task
+	 */
+	void runGeneration(size_t tasksCount, const std::function<void(size_t)>& task);
+
+public:
+	/**
+	 * Constructor
+	 * @param threadsCount number of threads (including the calling thread), 0 for the number of cores
+	 */
+	ThreadPool(unsigned int threadsCount = 0);
+
+	/**
+	 * Destructor (join the workers)
+	 */
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * Get number of threads (including the calling thread)
+	 * @return number of threads
+	 */
+	unsigned int getThreadsCount() const;
+
+	/**
+	 * Run task(0) .. task(tasksCount - 1) on the threads and wait for the end of all of them
+	 * (called from a task of this pool, the tasks run one after the other on the thread)
+	 * @param tasksCount number of tasks
+	 * @param task task to run with the index of the task
+	 * @throw invalid_argument if there are 2^32 tasks or more
+	 * @throw the first exception thrown by a task
+	 */
+	void run(size_t tasksCount, const std::function<void(size_t)>& task);
+
+	/**
+	 * Run task(0) .. task(tasksCount - 1) on the threads if the pool is free, otherwise on the
+	 * calling thread (the caller never waits for another run: concurrent callers are not
+	 * serialized)
+	 * @param tasksCount number of tasks
+	 * @param task task to run with the index of the task
+	 * @return true if the tasks ran on the threads of the pool
+	 * @throw invalid_argument if there are 2^32 tasks or more
+	 * @throw the first exception thrown by a task
+	 */
+	bool tryRun(size_t tasksCount, const std::function<void(size_t)>& task);
+};
+
+#endif /* THREADPOOL_THREADPOOL_HPP_ */
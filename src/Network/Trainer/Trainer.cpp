@@ -0,0 +1,195 @@
+/*
+ * Trainer.cpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#include <stdexcept>
+#include <algorithm>
+#include <chrono>
+
+#include "Trainer.hpp"
+#include "../DatasetReader/DatasetReader.hpp"
+#include "../Checkpointer/Checkpointer.hpp"
+
+template<typename T>
+Trainer<T>::Trainer(Network<T>& network, const Dataset<T>& trainingSet, const Dataset<T>& validationSet, const TrainerConfig& config) : network(network), trainingSet(trainingSet), validationSet(validationSet), config(config) {
+	// Check if the network is ready
+	size_t layersCount = network.getLayersCount();
+	if (layersCount < 2 || network.getLayer(layersCount - 1).getType() != NeuralType::OUTPUT_NEURAL) {
+		throw std::logic_error("The network is not complete");
+	}
+
+	// Control input parameters: datasets
+	unsigned int inputsCount = network.getLayer(0).getNeuralsCount();
+	unsigned int outputsCount = network.getLayer(layersCount - 1).getNeuralsCount();
+	for (const Dataset<T>* dataset : { &trainingSet, &validationSet }) {
+		if (dataset->getSamplesCount() == 0) {
+			throw std::invalid_argument("The datasets should not be empty");
+		}
+		if (dataset->getInputsCount() != inputsCount || dataset->getOutputsCount() != outputsCount) {
+			throw std::invalid_argument("The datasets should have as many input and expected values as the input and output layers");
+		}
+	}
+
+	// Control input parameters: configuration
+	if (config.batchSize == 0 || config.validationBatchSize == 0) {
+		throw std::invalid_argument("The batch sizes should not be 0");
+	}
+	if (config.maxEpochs == 0) {
+		throw std::invalid_argument("The max number of epochs should not be 0");
+	}
+	if (!(config.minDelta >= 0)) {
+		throw std::invalid_argument("The min delta should not be negative");
+	}
+	if (!config.checkpointPrefix.empty() && config.checkpointInterval == 0) {
+		throw std::invalid_argument("The checkpoint interval should not be 0");
+	}
+
+	bestEpoch = 0;
+}
+
+template<typename T>
+void Trainer<T>::setEpochCallback(std::function<void(const EpochReport&)> epochCallback) {
+	this->epochCallback = epochCallback;
+}
+
+template<typename T>
+void Trainer<T>::validate(EpochReport& report) const {
+	size_t samplesCount = validationSet.getSamplesCount();
+	size_t inputsCount = validationSet.getInputsCount();
+	size_t outputsCount = validationSet.getOutputsCount();
+
+	// One task by range of samples, the sums are added in the order of the tasks
+	size_t tasksCount = (samplesCount + config.validationBatchSize - 1) / config.validationBatchSize;
+	std::vector<double> losses(tasksCount);
+	std::vector<size_t> corrects(tasksCount);
+	auto task = [&](size_t t) {
+		size_t first = t * config.validationBatchSize;
+		size_t count = std::min(config.validationBatchSize, samplesCount - first);
+
+		// Gather the samples of the task (read in place in the mapping)
+		Matrix<T> inputValues(count, inputsCount);
+		Matrix<T> expectedValues(count, outputsCount);
+		Matrix<T> outputValues;
+		for (size_t r = 0; r < count; ++r) {
+			std::copy(validationSet.getInputValues(first + r), validationSet.getInputValues(first + r) + inputsCount, inputValues.row(r));
+			std::copy(validationSet.getExpectedValues(first + r), validationSet.getExpectedValues(first + r) + outputsCount, expectedValues.row(r));
+		}
+		losses[t] = (double) network.evaluate(inputValues, expectedValues, outputValues) * count;
+
+		// Max class against max expected value
+		size_t correct = 0;
+		for (size_t r = 0; r < count; ++r) {
+			const T* outputs = outputValues.row(r);
+			const T* expected = expectedValues.row(r);
+			correct += (std::max_element(outputs, outputs + outputsCount) - outputs) == (std::max_element(expected, expected + outputsCount) - expected);
+		}
+		corrects[t] = correct;
+	};
+	if (config.threadPool && tasksCount > 1) {
+		config.threadPool->run(tasksCount, task);
+	} else {
+		for (size_t t = 0; t < tasksCount; ++t) {
+			task(t);
+		}
+	}
+
+	double sumLoss = 0;
+	size_t correct = 0;
+	for (size_t t = 0; t < tasksCount; ++t) {
+		sumLoss += losses[t];
+		correct += corrects[t];
+	}
+	report.validationLoss = sumLoss / samplesCount;
+	report.validationAccuracy = correct / (double) samplesCount;
+}
+
+template<typename T>
+std::vector<EpochReport> Trainer<T>::run() {
+	typedef std::chrono::steady_clock Clock;
+
+	DatasetReader<T> reader(trainingSet, config.batchSize, config.shuffle, config.seed);
+	std::unique_ptr<Checkpointer<T>> checkpointer;
+	if (!config.checkpointPrefix.empty()) {
+		checkpointer = std::make_unique<Checkpointer<T>>(network, config.checkpointPrefix, config.checkpointsKept);
+	}
+	std::vector<T> bestParameters;
+	if (config.restoreBest) {
+		bestParameters.resize(network.getParametersCount());
+	}
+	uint64_t step = 0;
+	std::vector<EpochReport> reports;
+	double bestMeasure = 0;
+	bestEpoch = 0;
+	for (unsigned int epoch = 1; epoch <= config.maxEpochs; ++epoch) {
+		EpochReport report = EpochReport();
+		report.epoch = epoch;
+
+		// Learn every sample once (mean loss of the mini-batches weighted by their size)
+		Clock::time_point start = Clock::now();
+		double sumLoss = 0;
+		for (size_t b = 0; b < reader.getBatchesCount(); ++b) {
+			reader.next();
+			size_t count = reader.getInputValues().getRowsCount();
+			network.learnBatch(reader.getInputValues(), reader.getExpectedValues());
+			sumLoss += (double) network.getLoss() * count;
+			report.samplesCount += count;
+
+			// Snapshot between two mini-batches (written in the background)
+			if (checkpointer && ++step % config.checkpointInterval == 0) {
+				checkpointer->snapshot(step);
+			}
+		}
+		report.trainingSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+		report.trainingLoss = sumLoss / report.samplesCount;
+		report.samplesPerSecond = report.samplesCount / std::max(report.trainingSeconds, 1e-9);
+
+		// Held-out measures
+		start = Clock::now();
+		validate(report);
+		report.validationSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+		// Improvement of the validation measure (a lower loss or a higher accuracy)
+		double measure = (config.stoppingMetric == StoppingMetric::LOSS) ? -report.validationLoss : report.validationAccuracy;
+		if (bestEpoch == 0 || measure > bestMeasure + config.minDelta) {
+			bestMeasure = measure;
+			bestEpoch = epoch;
+			report.isBest = true;
+			if (config.restoreBest) {
+				network.copyParameters(bestParameters.data());
+			}
+			if (!config.bestModelPath.empty()) {
+				network.save(config.bestModelPath);
+			}
+		}
+
+		reports.push_back(report);
+		if (epochCallback) {
+			epochCallback(report);
+		}
+
+		// Early stopping
+		if (config.patience > 0 && epoch - bestEpoch >= config.patience) {
+			break;
+		}
+	}
+	if (checkpointer) {
+		checkpointer->wait();
+	}
+
+	// Weights of the best epoch (the state of the optimizer is the one of the last epoch)
+	if (config.restoreBest && bestEpoch != reports.size()) {
+		network.setParameters(bestParameters.data());
+	}
+	return reports;
+}
+
+template<typename T>
+unsigned int Trainer<T>::getBestEpoch() const {
+	return bestEpoch;
+}
+
+template class Trainer<float>;
+template class Trainer<double>;
@@ -0,0 +1,235 @@
+/*
+ * Trainer.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef TRAINER_TRAINER_HPP_
+#define TRAINER_TRAINER_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include <functional>
+
+#include "../../constant.h"
+
+#include "../Network.hpp"
+#include "../Dataset/Dataset.hpp"
+#include "../ThreadPool/ThreadPool.hpp"
+
+/**
+ * Epochs and early stopping of a training
+ */
+struct TrainerConfig {
+	/**
+	 * Number of samples by mini-batch [default = 32]
+	 */
+	size_t batchSize = 32;
+
+	/**
+	 * Max number of epochs [default = 100]
+	 */
+	unsigned int maxEpochs = 100;
+
+	/**
+	 * Shuffle the training samples at each epoch [default = true]
+	 */
+	bool shuffle = true;
+
+	/**
+	 * Seed of the shuffling [default = random]
+	 */
+	uint64_t seed = std::random_device()();
+
+	/**
+	 * Validation measure of the early stopping [default = LOSS]
+	 */
+	StoppingMetric stoppingMetric = StoppingMetric::LOSS;
+
+	/**
+	 * Number of epochs without improvement before stopping (0: no early stopping) [default = 5]
+	 */
+	unsigned int patience = 5;
+
+	/**
+	 * Smallest change of the validation measure counted as an improvement [default = 0]
+	 */
+	double minDelta = 0;
+
+	/**
+	 * Number of samples by validation task [default = 1024]
+	 */
+	size_t validationBatchSize = 1024;
+
+	/**
+	 * Threads of the validation, can be the pool of the network [default = null: single thread]
+	 */
+	std::shared_ptr<ThreadPool> threadPool;
+
+	/**
+	 * Model file saved at each improvement (see Network::save) [default = empty: not saved]
+	 */
+	std::string bestModelPath;
+
+	/**
+	 * Leave the network with the weights of the best epoch at the end of the training (copied
+	 * in memory at each improvement) [default = true]
+	 */
+	bool restoreBest = true;
+
+	/**
+	 * Start of the paths of the checkpoints written in the background (see Checkpointer)
+	 * [default = empty: no checkpoint]
+	 */
+	std::string checkpointPrefix;
+
+	/**
+	 * Number of mini-batches between two checkpoints [default = 1000]
+	 */
+	unsigned int checkpointInterval = 1000;
+
+	/**
+	 * Number of checkpoints kept, the oldest are removed (0: all) [default = 3]
+	 */
+	unsigned int checkpointsKept = 3;
+};
+
+/**
+ * Measures of one epoch
+ */
+struct EpochReport {
+	/**
+	 * Epoch number (from 1)
+	 */
+	unsigned int epoch;
+
+	/**
+	 * Number of learned samples
+	 */
+	size_t samplesCount;
+
+	/**
+	 * Mean loss of the learned mini-batches
+	 */
+	double trainingLoss;
+
+	/**
+	 * Mean loss of the validation samples
+	 */
+	double validationLoss;
+
+	/**
+	 * Ratio of validation samples with the max class equal to the max expected value
+	 */
+	double validationAccuracy;
+
+	/**
+	 * Duration of the learning (in seconds)
+	 */
+	double trainingSeconds;
+
+	/**
+	 * Samples learned by second
+	 */
+	double samplesPerSecond;
+
+	/**
+	 * Duration of the validation (in seconds)
+	 */
+	double validationSeconds;
+
+	/**
+	 * Best validation measure so far
+	 */
+	bool isBest;
+};
+
+/**
+ * Training of a network by epochs over a dataset
+ *
+ * Each epoch learns every sample once by mini-batches (shuffled and prefetched, see
+ * DatasetReader), then measures the loss and the accuracy on a held-out validation set (by
+ * tasks run on the threads of the pool). The training stops when the validation measure has
+ * not improved for a number of epochs or after the max number of epochs: the network is left
+ * with the weights of the best epoch (or of the last one, see TrainerConfig::restoreBest), the
+ * best one can also be saved as a model. Checkpoints of the learning can be written in the
+ * background every number of mini-batches
+ */
+template<typename T>
+class Trainer {
+protected:
+	/**
+	 * Trained network
+	 */
+	Network<T>& network;
+
+	/**
+	 * Training set (must outlive the trainer)
+	 */
+	const Dataset<T>& trainingSet;
+
+	/**
+	 * Validation set (must outlive the trainer)
+	 */
+	const Dataset<T>& validationSet;
+
+	/**
+	 * Epochs and early stopping
+	 */
+	TrainerConfig config;
+
+	/**
+	 * Called after each epoch (none: no call)
+	 */
+	std::function<void(const EpochReport&)> epochCallback;
+
+	/**
+	 * Epoch of the best validation measure (0 before the first epoch)
+	 */
+	unsigned int bestEpoch;
+
+protected:
+	/**
+	 * Measure the validation loss and accuracy of the network
+	 * @param report report of the epoch
+	 */
+	void validate(EpochReport& report) const;
+
+public:
+	/**
+	 * Constructor (the network and the datasets are kept by reference)
+	 * @param network network to train
+	 * @param trainingSet training set
+	 * @param validationSet validation set
+	 * @param config epochs and early stopping
+	 * @throw logic_error if the network is not complete
+	 * @throw invalid_argument if a dataset does not match the network or the configuration is not valid
+	 */
+	Trainer(Network<T>& network, const Dataset<T>& trainingSet, const Dataset<T>& validationSet, const TrainerConfig& config = TrainerConfig());
+
+	/**
+	 * Set the call after each epoch
+	 * @param epochCallback called with the report of the epoch (none: no call)
+	 */
+	void setEpochCallback(std::function<void(const EpochReport&)> epochCallback);
+
+	/**
+	 * Train the network until the early stopping or the max number of epochs (the network is
+	 * left with the weights of the best epoch, see TrainerConfig::restoreBest)
+	 * @return report of each epoch
+	 * @throw runtime_error if the best model or a checkpoint can not be written
+	 */
+	std::vector<EpochReport> run();
+
+	/**
+	 * Get epoch of the best validation measure of the last run
+	 * @return epoch number (0 before the first epoch)
+	 */
+	unsigned int getBestEpoch() const;
+};
+
+#endif /* TRAINER_TRAINER_HPP_ */
@@ -0,0 +1,53 @@
+/*
+ * TrainingConfig.hpp
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: Jean-François Erdelyi
+ */
+
+#ifndef TRAININGCONFIG_TRAININGCONFIG_HPP_
+#define TRAININGCONFIG_TRAININGCONFIG_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <random>
+
+#include "../../constant.h"
+#include "../ThreadPool/ThreadPool.hpp"
+
+/**
+ * Hyperparameters and random seed of the learning of one network
+ *
+ * Nothing is global: each network owns its configuration and its random generator, the
+ * networks of a process can be built and trained concurrently (and reproduced with their seed)
+ */
+template<typename T>
+struct TrainingConfig {
+	/**
+	 * Alpha value used in weight computation, usualy between 0.0 and 1.0 [default = 0.01]
+	 */
+	T learningRate = (T) 0.01;
+
+	/**
+	 * Loss function type [default = MSE]
+	 */
+	LossFunctionType lossFunctionType = LossFunctionType::MSE;
+
+	/**
+	 * Update rule of the weights [default = SGD]
+	 */
+	OptimizerType optimizerType = OptimizerType::SGD;
+
+	/**
+	 * Seed of the random generator of the network (initial weights) [default = random]
+	 */
+	uint64_t seed = std::random_device()();
+
+	/**
+	 * Threads of the mini-batch learning and of the wide layers of one sample, can be shared by
+	 * several networks (the calls are serialized by the pool) [default = null: single thread]
+	 */
+	std::shared_ptr<ThreadPool> threadPool;
+};
+
+#endif /* TRAININGCONFIG_TRAININGCONFIG_HPP_ */
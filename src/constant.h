@@ -12,22 +12,42 @@ enum class AggregationType {
 	NO_AGG, SUM
 };
 
-// Neural excitation methods
+// Links coming from the previous layer (every neural, random subset, local window or explicit lists)
+enum class ConnectionType {
+	FULL, RANDOM, LOCAL, ADJACENCY
+};
+
+// Neural excitation methods (softmax: output layer only, normalized over the layer)
 enum class ExcitationType {
-	NO_EXC, SIGMOID, STEP, TAN_HYP
+	NO_EXC, SIGMOID, STEP, TAN_HYP, SOFTMAX
 };
 
-// Loss function
+// Loss function (cross-entropy: softmax output layer only)
 enum class LossFunctionType {
-	MSE
+	MSE, CROSS_ENTROPY
 };
 
-// Neural types
-enum class NeuralType {
-	INPUT_NEURAL, OUTPUT_NEURAL, HIDDEN_NEURAL, BIAIS_NEURAL
+// Update rule of the weights
+enum class OptimizerType {
+	SGD, MOMENTUM, NESTEROV, ADAM
+};
+
+// Validation measure of the early stopping (lower loss or higher accuracy is better)
+enum class StoppingMetric {
+	LOSS, ACCURACY
 };
 
-// Connect direction
-enum class ConnectDirection {
-	FORWARD, BACKWARD, BOTH
+// Quantization of the weights (one scale by layer or by neural)
+enum class QuantizationType {
+	PER_LAYER, PER_ROW
+};
+
+// Profiled phases of the learning and of the estimation
+enum class ProfilePhase {
+	ESTIMATE, FORWARD, OUTPUT_DELTA, DELTA, GRADIENT, UPDATE
+};
+
+// Neural types
+enum class NeuralType {
+	INPUT_NEURAL, OUTPUT_NEURAL, HIDDEN_NEURAL
 };
@@ -8,12 +8,14 @@
 #include <iostream>
 #include "constant.h"
 #include "Network/Network.hpp"
+#include "Network/Dataset/Dataset.hpp"
+#include "Network/Trainer/Trainer.hpp"
 
 using namespace std;
 
 int main() {
 	// Build ANN
-	Network n = Network(0.1);	
+	Network<double> n = Network<double>(0.1);	
 	n.addInputLayer(3);
 	n.addLayer(3, AggregationType::SUM, ExcitationType::SIGMOID);
 	
@@ -23,41 +25,44 @@ int main() {
 	n.addLayer(2, AggregationType::SUM, ExcitationType::SIGMOID);
 	n.addOutputLayer(2, AggregationType::SUM, ExcitationType::SIGMOID);
 
-	// Learn
-	int j = 0;
+	// Samples: the expected class is given by the first input value
+	auto fill = [](Matrix<double>& inputValues, Matrix<double>& expectedValues) {
+		for (size_t r = 0; r < inputValues.getRowsCount(); ++r) {
+			for (size_t c = 0; c < 3; ++c) {
+				inputValues.at(r, c) = (rand() % 100) / 100.0;
+			}
+			double expValue = (inputValues.at(r, 0) < 0.5) ? 0 : 1;
+			expectedValues.at(r, 0) = expValue;
+			expectedValues.at(r, 1) = 1 - expValue;
+		}
+	};
+	Matrix<double> trainingInputs(10000, 3), trainingExpected(10000, 2);
+	Matrix<double> validationInputs(2000, 3), validationExpected(2000, 2);
+	fill(trainingInputs, trainingExpected);
+	fill(validationInputs, validationExpected);
+	Dataset<double>::write("training.annd", trainingInputs, trainingExpected);
+	Dataset<double>::write("validation.annd", validationInputs, validationExpected);
+	Dataset<double> trainingSet("training.annd");
+	Dataset<double> validationSet("validation.annd");
+
+	// Learn by epochs until the validation loss stops improving
 	cout << "LEARN" << endl;
-	
-	vector<double> vectorsI(3);
-	vector<double> vectorsE(2);
+	TrainerConfig config;
+	config.batchSize = 1;
+	config.maxEpochs = 50;
+	config.patience = 10;
+	Trainer<double> trainer(n, trainingSet, validationSet, config);
+	trainer.setEpochCallback([](const EpochReport& report) {
+		cout << "Epoch " << report.epoch << ": loss " << report.trainingLoss << ", validation loss " << report.validationLoss
+			<< ", validation accuracy " << report.validationAccuracy * 100 << "%, " << report.samplesPerSecond << " samples/s" << endl;
+	});
+	trainer.run();
+	cout << "Best epoch: " << trainer.getBestEpoch() << endl;
 
+	vector<double> testValue(3);
 	double input1 = 0;
 	double input2 = 0;
 	double input3 = 0;
-
-	double expValue;
-	do {
-		input1 = (rand() % 100) / 100.0;     
-		input2 = (rand() % 100) / 100.0;
-		input3 = (rand() % 100) / 100.0;
-
-		if (input1 < 0.5) {
-			expValue = 0;
-		} else {
-			expValue = 1;
-		}
-
-		vectorsI.at(0) = input1;
-		vectorsI.at(1) = input2;
-		vectorsI.at(2) = input3;
-
-		vectorsE.at(0) = expValue;
-		vectorsE.at(1) = 1 - expValue;
-		n.learn(vectorsI, vectorsE);
-		j++;
-	} while (n.getLoss() > 0.01);
-	cout << j << endl;
-
-	vector<double> testValue(3);
 	int ok = 0;
 	int nbTry = 1000;
 	for (int i = 0; i < nbTry; ++i) {
@@ -76,7 +81,14 @@ int main() {
 		}
 	}
 
-	n.print();
-	cout << "Sucess rate: "  << (ok / (double)nbTry) * 100 << "%" << endl;
+	// Output values of one sample (weights of the best epoch)
+	vector<double> outputValues;
+	Scratch<double> scratch;
+	testValue.at(0) = 0.25;
+	testValue.at(1) = 0.5;
+	testValue.at(2) = 0.75;
+	int estimatedClass = n.estimate(testValue, outputValues, scratch);
+	cout << "Estimate of (0.25, 0.5, 0.75): class " << estimatedClass << ", output values " << outputValues.at(0) << " " << outputValues.at(1) << endl;
+	cout << "Success rate: "  << (ok / (double)nbTry) * 100 << "%" << endl;
 	return 0;
 }